@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+"""Сравнение двух JSON-отчётов Google Benchmark (--benchmark_out).
+
+Использование: compare.py baseline.json current.json [--threshold 0.10]
+
+Для каждого теста, который есть в обоих отчётах, печатается отношение
+времени current / baseline. Тест считается регрессией, если он стал
+медленнее более чем на threshold; при регрессиях код возврата - 1.
+"""
+
+import argparse
+import json
+import sys
+
+_UNITS = {"ns": 1e-9, "us": 1e-6, "ms": 1e-3, "s": 1.0}
+
+
+def load(path):
+    with open(path, encoding="utf-8") as file:
+        report = json.load(file)
+    times = {}
+    for run in report["benchmarks"]:
+        # агрегаты повторов (mean, median, stddev) не сравниваем
+        if run.get("run_type") == "aggregate":
+            continue
+        times[run["name"]] = run["real_time"] * _UNITS[run["time_unit"]]
+    return times
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="допустимое замедление (0.10 = 10%%)")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+    regressions = 0
+    print(f"{'benchmark':<40} {'baseline':>12} {'current':>12} {'ratio':>8}")
+    for name, time in current.items():
+        if name not in baseline:
+            print(f"{name:<40} {'-':>12} {time:>12.3e} {'new':>8}")
+            continue
+        ratio = time / baseline[name]
+        mark = ""
+        if ratio > 1.0 + args.threshold:
+            mark = "  REGRESSION"
+            regressions += 1
+        print(f"{name:<40} {baseline[name]:>12.3e} {time:>12.3e} "
+              f"{ratio:>8.3f}{mark}")
+    for name in baseline.keys() - current.keys():
+        print(f"{name:<40} missing in current report")
+
+    if regressions:
+        print(f"\n{regressions} regression(s) over {args.threshold:.0%}")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
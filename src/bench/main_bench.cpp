@@ -0,0 +1,280 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+#include <vector>
+
+#include "../main_functions/s21_matrix_batch.h"
+#include "../main_functions/s21_matrix_oop.h"
+#include "../main_functions/s21_matrix_strassen.h"
+#include "../main_functions/s21_matrix_text.h"
+#include "../main_functions/s21_matrix_tiled.h"
+
+namespace BenchCase {
+void genMatrix(S21Matrix &matrix) {
+  for (int i = 0; i < matrix.GetRows(); ++i) {
+    for (int j = 0; j < matrix.GetCols(); ++j) {
+      matrix(i, j) = rand() % 24 - 12;
+    }
+  }
+}
+
+// прежний алгоритм: рекурсивное разложение по первой строке
+double cofactorDeterminant(const S21Matrix &matrix) {
+  const int n = matrix.GetRows();
+  double det = 0;
+  if (n == 1) {
+    det = matrix(0, 0);
+  } else if (n == 2) {
+    det = matrix(0, 0) * matrix(1, 1) - matrix(0, 1) * matrix(1, 0);
+  } else {
+    for (int skip = 0; skip < n; ++skip) {
+      S21Matrix minor(n - 1, n - 1);
+      for (int i = 1; i < n; ++i) {
+        for (int j = 0, sub_j = 0; j < n; ++j) {
+          if (j != skip) minor(i - 1, sub_j++) = matrix(i, j);
+        }
+      }
+      det += (skip % 2 == 0 ? 1 : -1) * matrix(0, skip) *
+             cofactorDeterminant(minor);
+    }
+  }
+  return det;
+}
+
+// прежний алгоритм: цикл i-j-k через operator()
+S21Matrix naiveMul(const S21Matrix &a, const S21Matrix &b) {
+  S21Matrix result(a.GetRows(), b.GetCols());
+  for (int i = 0; i < a.GetRows(); i++) {
+    for (int j = 0; j < b.GetCols(); j++) {
+      for (int k = 0; k < a.GetCols(); k++) {
+        result(i, j) += a(i, k) * b(k, j);
+      }
+    }
+  }
+  return result;
+}
+
+// наибольшая относительная ошибка c по 64 случайным элементам
+// относительно скалярного произведения в long double
+double sampledError(const S21Matrix &a, const S21Matrix &b,
+                    const S21Matrix &c) {
+  double error = 0;
+  for (int sample = 0; sample < 64; ++sample) {
+    const int i = rand() % c.GetRows(), j = rand() % c.GetCols();
+    long double exact = 0, norm = 0;
+    for (int k = 0; k < a.GetCols(); ++k) {
+      exact += static_cast<long double>(a(i, k)) * b(k, j);
+      norm += std::abs(static_cast<long double>(a(i, k)) * b(k, j));
+    }
+    error = std::max(error, static_cast<double>(std::abs(c(i, j) - exact) /
+                                                norm));
+  }
+  return error;
+}
+
+// среднее время одного вызова в микросекундах
+template <typename Func>
+double measure(Func func) {
+  using Clock = std::chrono::steady_clock;
+  int iterations = 0;
+  volatile double sink = 0;
+  const auto start = Clock::now();
+  auto now = start;
+  do {
+    sink = sink + func();
+    ++iterations;
+    now = Clock::now();
+  } while (now - start < std::chrono::milliseconds(50));
+  return std::chrono::duration<double, std::micro>(now - start).count() /
+         iterations;
+}
+}  // namespace BenchCase
+
+void benchDeterminant() {
+  std::printf("Determinant: cofactor vs LU (us per call)\n");
+  std::printf("%4s %14s %14s\n", "n", "cofactor", "Determinant()");
+  for (int n = 2; n <= 10; ++n) {
+    S21Matrix matrix(n, n);
+    BenchCase::genMatrix(matrix);
+    double cofactor = BenchCase::measure(
+        [&matrix] { return BenchCase::cofactorDeterminant(matrix); });
+    double current =
+        BenchCase::measure([&matrix] { return matrix.Determinant(); });
+    std::printf("%4d %14.3f %14.3f\n", n, cofactor, current);
+  }
+  for (int n = 64; n <= 512; n *= 2) {
+    S21Matrix matrix(n, n);
+    BenchCase::genMatrix(matrix);
+    double current =
+        BenchCase::measure([&matrix] { return matrix.Determinant(); });
+    std::printf("%4d %14s %14.3f\n", n, "-", current);
+  }
+}
+
+void benchMulMatrix() {
+  std::printf("\nMulMatrix: i-j-k loop vs blocked GEMM (GFLOP/s)\n");
+  std::printf("%6s %12s %12s %12s\n", "n", "i-j-k", "MulMatrix",
+              "Transposed");
+  for (int n = 128; n <= 1024; n *= 2) {
+    S21Matrix a(n, n);
+    S21Matrix b(n, n);
+    BenchCase::genMatrix(a);
+    BenchCase::genMatrix(b);
+    const double flops = 2.0 * n * n * n;
+    double naive = 0;
+    if (n <= 512) {
+      naive = BenchCase::measure(
+          [&] { return BenchCase::naiveMul(a, b)(0, 0); });
+    }
+    double blocked = BenchCase::measure([&] {
+      S21Matrix c(a);
+      c.MulMatrix(b);
+      return c(0, 0);
+    });
+    double transposed = BenchCase::measure([&] {
+      S21Matrix c(a);
+      c.MulTransposedMatrix(b);
+      return c(0, 0);
+    });
+    // цикл i-j-k на больших размерах слишком долгий, пропускаем
+    if (naive > 0) {
+      std::printf("%6d %12.2f", n, flops / naive / 1e3);
+    } else {
+      std::printf("%6d %12s", n, "-");
+    }
+    std::printf(" %12.2f %12.2f\n", flops / blocked / 1e3,
+                flops / transposed / 1e3);
+  }
+}
+
+void benchBatch() {
+  std::printf("\nBatch of 8x8: per-matrix calls vs batched (ms per batch)\n");
+  std::printf("%8s %12s %12s %12s %12s\n", "count", "Mul", "BatchMul",
+              "Inverse", "BatchInverse");
+  for (int count = 1000; count <= 100000; count *= 10) {
+    std::vector<S21Matrix> matrices(count, S21Matrix(8, 8));
+    S21MatrixBatch batch(count, 8, 8);
+    for (int k = 0; k < count; ++k) {
+      BenchCase::genMatrix(matrices[k]);
+      for (int i = 0; i < 8; ++i) matrices[k](i, i) += 100;
+      batch.Set(k, matrices[k]);
+    }
+    double single_mul = BenchCase::measure([&] {
+      double sum = 0;
+      for (const S21Matrix &matrix : matrices) sum += (matrix * matrix)(0, 0);
+      return sum;
+    });
+    double batch_mul =
+        BenchCase::measure([&] { return S21BatchMul(batch, batch)(0, 0, 0); });
+    double single_inverse = BenchCase::measure([&] {
+      double sum = 0;
+      for (const S21Matrix &matrix : matrices) {
+        sum += matrix.InverseMatrix()(0, 0);
+      }
+      return sum;
+    });
+    double batch_inverse =
+        BenchCase::measure([&] { return S21BatchInverse(batch)(0, 0, 0); });
+    std::printf("%8d %12.3f %12.3f %12.3f %12.3f\n", count, single_mul / 1e3,
+                batch_mul / 1e3, single_inverse / 1e3, batch_inverse / 1e3);
+  }
+}
+
+void benchStrassen() {
+  std::printf("\nMulMatrix vs S21MulStrassen (s per call, relative error)\n");
+  std::printf("%6s %8s %12s %12s %12s %12s\n", "n", "cutoff", "MulMatrix",
+              "Strassen", "err classic", "err Strassen");
+  for (int n = 1024; n <= 4096; n *= 2) {
+    S21Matrix a(n, n), b(n, n);
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        a(i, j) = 2.0 * rand() / RAND_MAX - 1.0;
+        b(i, j) = 2.0 * rand() / RAND_MAX - 1.0;
+      }
+    }
+    S21Matrix classic = a * b;
+    const double classic_time =
+        BenchCase::measure([&] { return (a * b)(0, 0); });
+    const double classic_error = BenchCase::sampledError(a, b, classic);
+    for (int cutoff = 256; cutoff <= 1024; cutoff *= 2) {
+      if (cutoff >= n) break;
+      S21Matrix fast = S21MulStrassen(a.View(), b.View(), cutoff);
+      const double fast_time = BenchCase::measure(
+          [&] { return S21MulStrassen(a.View(), b.View(), cutoff)(0, 0); });
+      std::printf("%6d %8d %12.3f %12.3f %12.2e %12.2e\n", n, cutoff,
+                  classic_time / 1e6, fast_time / 1e6, classic_error,
+                  BenchCase::sampledError(a, b, fast));
+    }
+  }
+}
+
+void benchTiled() {
+  std::printf("\nTiled 2048x2048, tile 256, cache of 8 tiles (s per call)\n");
+  std::printf("%10s %12s %12s %12s\n", "prefetch", "MulNumber", "Transpose",
+              "MulMatrix");
+  S21Matrix a(2048, 2048);
+  BenchCase::genMatrix(a);
+  S21TileOptions options;
+  options.cache_bytes = 8 * 256 * 256 * sizeof(double);
+  for (bool prefetch : {false, true}) {
+    options.prefetch = prefetch;
+    S21TiledMatrix tiled("bench_tiled_a", 2048, 2048, options);
+    tiled.Store(a, 0, 0);
+    tiled.Flush();
+    const double scale = BenchCase::measure([&] {
+      tiled.MulNumber(-1.0);
+      return 0.0;
+    });
+    const double transpose = BenchCase::measure(
+        [&] { return tiled.Transpose("bench_tiled_t")(0, 0); });
+    const double product = BenchCase::measure(
+        [&] { return tiled.MulMatrix(tiled, "bench_tiled_c")(0, 0); });
+    std::printf("%10s %12.3f %12.3f %12.3f\n", prefetch ? "on" : "off",
+                scale / 1e6, transpose / 1e6, product / 1e6);
+  }
+  for (const char *path : {"bench_tiled_a", "bench_tiled_t", "bench_tiled_c"}) {
+    std::remove(path);
+  }
+}
+
+void benchText() {
+  std::printf("\nText 2000x500: iostream + operator() vs S21ReadText (ms)\n");
+  std::printf("%12s %12s %12s\n", "iostream", "ReadText", "WriteText");
+  S21Matrix a(2000, 500);
+  for (int i = 0; i < 2000; ++i) {
+    for (int j = 0; j < 500; ++j) a(i, j) = std::sin(i * 500.0 + j);
+  }
+  S21WriteText("bench_text.csv", a, {' ', 0});
+  const double stream = BenchCase::measure([] {
+    std::ifstream in("bench_text.csv");
+    S21Matrix matrix(2000, 500);
+    for (int i = 0; i < 2000; ++i) {
+      for (int j = 0; j < 500; ++j) in >> matrix(i, j);
+    }
+    return matrix(0, 0);
+  });
+  const double bulk = BenchCase::measure(
+      [] { return S21ReadText("bench_text.csv")(0, 0); });
+  const double write = BenchCase::measure([&a] {
+    S21WriteText("bench_text.csv", a, {' ', 0});
+    return 0.0;
+  });
+  std::printf("%12.1f %12.1f %12.1f\n", stream / 1e3, bulk / 1e3,
+              write / 1e3);
+  std::remove("bench_text.csv");
+}
+
+int main() {
+  srand(21);
+  benchDeterminant();
+  benchMulMatrix();
+  benchBatch();
+  benchStrassen();
+  benchTiled();
+  benchText();
+  return 0;
+}
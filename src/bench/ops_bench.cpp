@@ -0,0 +1,207 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <utility>
+
+#include "../main_functions/s21_matrix_oop.h"
+
+// Набор Google Benchmark по всем операциям S21Matrix. Аргументы -
+// число строк и столбцов. Счётчик FLOP/s - арифметика операции,
+// bytes_per_second - объём данных, который она обязана прочитать и
+// записать (нижняя оценка трафика памяти).
+namespace BenchCase {
+constexpr double kDouble = sizeof(double);
+
+S21Matrix genMatrix(int rows, int cols) {
+  S21Matrix matrix(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) matrix(i, j) = rand() % 24 - 12;
+  }
+  // диагональное преобладание: матрица заведомо обратима
+  for (int i = 0; i < rows && i < cols; ++i) matrix(i, i) += 24.0 * cols;
+  return matrix;
+}
+
+void report(benchmark::State &state, double flops, double bytes) {
+  if (flops > 0) {
+    state.counters["FLOP/s"] = benchmark::Counter(
+        flops, benchmark::Counter::kIsIterationInvariantRate);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+
+// квадратные размеры и вытянутые формы
+void shapes(benchmark::internal::Benchmark *bench) {
+  for (int n : {16, 64, 256, 1024}) bench->Args({n, n});
+  bench->Args({64, 4096})->Args({4096, 64});
+}
+
+void squares(benchmark::internal::Benchmark *bench) {
+  for (int n : {4, 16, 64, 256, 1024}) bench->Args({n, n});
+}
+}  // namespace BenchCase
+
+namespace {
+using BenchCase::kDouble;
+
+void Construct(benchmark::State &state) {
+  const int rows = state.range(0), cols = state.range(1);
+  for (auto _ : state) {
+    S21Matrix matrix(rows, cols);
+    benchmark::DoNotOptimize(matrix.data());
+  }
+  BenchCase::report(state, 0, kDouble * rows * cols);
+}
+BENCHMARK(Construct)->Apply(BenchCase::shapes);
+
+void Copy(benchmark::State &state) {
+  const S21Matrix source =
+      BenchCase::genMatrix(state.range(0), state.range(1));
+  for (auto _ : state) {
+    S21Matrix copy(source);
+    benchmark::DoNotOptimize(copy.data());
+  }
+  BenchCase::report(state, 0, 2 * kDouble * state.range(0) * state.range(1));
+}
+BENCHMARK(Copy)->Apply(BenchCase::shapes);
+
+void Move(benchmark::State &state) {
+  S21Matrix matrix = BenchCase::genMatrix(state.range(0), state.range(1));
+  for (auto _ : state) {
+    S21Matrix moved(std::move(matrix));
+    matrix = std::move(moved);
+    benchmark::DoNotOptimize(matrix.data());
+  }
+  BenchCase::report(state, 0, 0);
+}
+BENCHMARK(Move)->Apply(BenchCase::shapes);
+
+// рост вдвое и возврат к исходному размеру
+void SetRows(benchmark::State &state) {
+  const int rows = state.range(0), cols = state.range(1);
+  S21Matrix matrix = BenchCase::genMatrix(rows, cols);
+  for (auto _ : state) {
+    matrix.SetRows(2 * rows);
+    matrix.SetRows(rows);
+    benchmark::DoNotOptimize(matrix.data());
+  }
+  BenchCase::report(state, 0, 5 * kDouble * rows * cols);
+}
+BENCHMARK(SetRows)->Apply(BenchCase::shapes);
+
+void SetCols(benchmark::State &state) {
+  const int rows = state.range(0), cols = state.range(1);
+  S21Matrix matrix = BenchCase::genMatrix(rows, cols);
+  for (auto _ : state) {
+    matrix.SetCols(2 * cols);
+    matrix.SetCols(cols);
+    benchmark::DoNotOptimize(matrix.data());
+  }
+  BenchCase::report(state, 0, 5 * kDouble * rows * cols);
+}
+BENCHMARK(SetCols)->Apply(BenchCase::shapes);
+
+void EqMatrix(benchmark::State &state) {
+  const S21Matrix a = BenchCase::genMatrix(state.range(0), state.range(1));
+  const S21Matrix b(a);
+  for (auto _ : state) benchmark::DoNotOptimize(a.EqMatrix(b));
+  const double size = static_cast<double>(state.range(0)) * state.range(1);
+  BenchCase::report(state, size, 2 * kDouble * size);
+}
+BENCHMARK(EqMatrix)->Apply(BenchCase::shapes);
+
+void SumMatrix(benchmark::State &state) {
+  S21Matrix a = BenchCase::genMatrix(state.range(0), state.range(1));
+  const S21Matrix b = BenchCase::genMatrix(state.range(0), state.range(1));
+  for (auto _ : state) {
+    a.SumMatrix(b);
+    benchmark::DoNotOptimize(a.data());
+  }
+  const double size = static_cast<double>(state.range(0)) * state.range(1);
+  BenchCase::report(state, size, 3 * kDouble * size);
+}
+BENCHMARK(SumMatrix)->Apply(BenchCase::shapes);
+
+void SubMatrix(benchmark::State &state) {
+  S21Matrix a = BenchCase::genMatrix(state.range(0), state.range(1));
+  const S21Matrix b = BenchCase::genMatrix(state.range(0), state.range(1));
+  for (auto _ : state) {
+    a.SubMatrix(b);
+    benchmark::DoNotOptimize(a.data());
+  }
+  const double size = static_cast<double>(state.range(0)) * state.range(1);
+  BenchCase::report(state, size, 3 * kDouble * size);
+}
+BENCHMARK(SubMatrix)->Apply(BenchCase::shapes);
+
+void MulNumber(benchmark::State &state) {
+  S21Matrix a = BenchCase::genMatrix(state.range(0), state.range(1));
+  for (auto _ : state) {
+    // множитель -1 не даёт значениям расти
+    a.MulNumber(-1.0);
+    benchmark::DoNotOptimize(a.data());
+  }
+  const double size = static_cast<double>(state.range(0)) * state.range(1);
+  BenchCase::report(state, size, 2 * kDouble * size);
+}
+BENCHMARK(MulNumber)->Apply(BenchCase::shapes);
+
+// (rows x cols) * (cols x rows)
+void MulMatrix(benchmark::State &state) {
+  const int rows = state.range(0), cols = state.range(1);
+  const S21Matrix a = BenchCase::genMatrix(rows, cols);
+  const S21Matrix b = BenchCase::genMatrix(cols, rows);
+  for (auto _ : state) {
+    S21Matrix product = a * b;
+    benchmark::DoNotOptimize(product.data());
+  }
+  BenchCase::report(state, 2.0 * rows * rows * cols,
+                    kDouble * (2.0 * rows * cols + 1.0 * rows * rows));
+}
+BENCHMARK(MulMatrix)->Apply(BenchCase::shapes);
+
+void Transpose(benchmark::State &state) {
+  const S21Matrix a = BenchCase::genMatrix(state.range(0), state.range(1));
+  for (auto _ : state) {
+    S21Matrix transposed = a.Transpose();
+    benchmark::DoNotOptimize(transposed.data());
+  }
+  BenchCase::report(state, 0, 2 * kDouble * state.range(0) * state.range(1));
+}
+BENCHMARK(Transpose)->Apply(BenchCase::shapes);
+
+void Determinant(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix a = BenchCase::genMatrix(n, n);
+  for (auto _ : state) benchmark::DoNotOptimize(a.Determinant());
+  BenchCase::report(state, 2.0 / 3.0 * n * n * n, kDouble * n * n);
+}
+BENCHMARK(Determinant)->Apply(BenchCase::squares);
+
+void InverseMatrix(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix a = BenchCase::genMatrix(n, n);
+  for (auto _ : state) {
+    S21Matrix inverse = a.InverseMatrix();
+    benchmark::DoNotOptimize(inverse.data());
+  }
+  BenchCase::report(state, 2.0 * n * n * n, 2 * kDouble * n * n);
+}
+BENCHMARK(InverseMatrix)->Apply(BenchCase::squares);
+
+// n^2 определителей порядка n - 1, поэтому только малые размеры
+void CalcComplements(benchmark::State &state) {
+  const int n = state.range(0);
+  const S21Matrix a = BenchCase::genMatrix(n, n);
+  for (auto _ : state) {
+    S21Matrix complements = a.CalcComplements();
+    benchmark::DoNotOptimize(complements.data());
+  }
+  const double minor = n - 1.0;
+  BenchCase::report(state, 2.0 / 3.0 * n * n * minor * minor * minor,
+                    2 * kDouble * n * n);
+}
+BENCHMARK(CalcComplements)->Args({4, 4})->Args({16, 16})->Args({64, 64});
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,257 @@
+#include "s21_matrix_batch.h"
+
+#include <algorithm>  // std::min, std::copy, std::fill, std::swap
+#include <cmath>      // std::abs
+#include <cstddef>    // std::size_t
+#include <stdexcept>  // logic_error
+
+#include "s21_matrix_parallel.h"
+#include "s21_matrix_simd.h"
+
+namespace {
+constexpr int kLanes = S21MatrixBatch::kLanes;
+constexpr double kEpsilon = 1e-7;
+
+int Blocks(int count) { return (count + kLanes - 1) / kLanes; }
+
+// начало куска block партии
+template <typename Batch>
+auto BlockData(Batch &batch, int block) {
+  return batch.data() +
+         static_cast<long>(block) * batch.GetRows() * batch.GetCols() * kLanes;
+}
+
+// элементы (i, j) матриц куска с cols столбцами
+template <typename T>
+T *At(T *block, int cols, int i, int j) {
+  return block + (static_cast<long>(i) * cols + j) * kLanes;
+}
+
+// Исключение Гаусса для width матриц куска (a - n x n, b - n x m).
+// Ведущий элемент выбирается в каждой матрице свой, само исключение
+// идёт векторными ядрами по матрицам. full - исключение и над ведущей
+// строкой с её нормировкой (Гаусс-Жордан), тогда в b остаётся
+// A^-1 * B. В det - определители, 0 у вырожденных матриц: вырождена
+// матрица с нулевым ведущим элементом или меньшим tolerance по модулю.
+void Eliminate(double *a, double *b, int n, int m, int width, bool full,
+               double tolerance, double *det) {
+  const s21_kernels::SimdTable &simd = s21_kernels::Simd();
+  double best[kLanes], inverse[kLanes], factor[kLanes];
+  int pivot[kLanes];
+  std::fill(det, det + width, 1.0);
+  for (int k = 0; k < n; ++k) {
+    const double *diag = At(a, n, k, k);
+    for (int l = 0; l < width; ++l) {
+      best[l] = std::abs(diag[l]);
+      pivot[l] = k;
+    }
+    for (int i = k + 1; i < n; ++i) {
+      const double *cell = At(a, n, i, k);
+      for (int l = 0; l < width; ++l) {
+        if (std::abs(cell[l]) > best[l]) {
+          best[l] = std::abs(cell[l]);
+          pivot[l] = i;
+        }
+      }
+    }
+    // перестановка строк - своя в каждой матрице, поэтому поэлементно
+    for (int l = 0; l < width; ++l) {
+      if (pivot[l] == k) continue;
+      det[l] = -det[l];
+      for (int j = k; j < n; ++j) {
+        std::swap(At(a, n, k, j)[l], At(a, n, pivot[l], j)[l]);
+      }
+      for (int j = 0; j < m; ++j) {
+        std::swap(At(b, m, k, j)[l], At(b, m, pivot[l], j)[l]);
+      }
+    }
+    for (int l = 0; l < width; ++l) {
+      const bool singular = best[l] == 0.0 || best[l] < tolerance;
+      det[l] = singular ? 0.0 : det[l] * diag[l];
+      inverse[l] = singular ? 0.0 : 1.0 / diag[l];
+    }
+    if (full) {
+      for (int j = k + 1; j < n; ++j) simd.mul(At(a, n, k, j), inverse, width);
+      for (int j = 0; j < m; ++j) simd.mul(At(b, m, k, j), inverse, width);
+    }
+    for (int i = full ? 0 : k + 1; i < n; ++i) {
+      if (i == k) continue;
+      const double *head = At(a, n, i, k);
+      for (int l = 0; l < width; ++l) {
+        factor[l] = full ? -head[l] : -head[l] * inverse[l];
+      }
+      for (int j = k + 1; j < n; ++j) {
+        simd.mul_add(At(a, n, i, j), factor, At(a, n, k, j), width);
+      }
+      for (int j = 0; j < m; ++j) {
+        simd.mul_add(At(b, m, i, j), factor, At(b, m, k, j), width);
+      }
+    }
+  }
+}
+
+void CheckSquare(const S21MatrixBatch &a, const char *message) {
+  if (a.GetRows() != a.GetCols()) {
+    throw std::logic_error(message);
+  }
+}
+
+// Гаусс-Жордан по кускам партии: result - правая часть n x m, после
+// исключения в ней остаётся решение; a копируется в рабочий массив
+void GaussJordan(const S21MatrixBatch &a, S21MatrixBatch &result,
+                 const char *message) {
+  const int n = a.GetRows(), m = result.GetCols(), count = a.GetCount();
+  const long work = static_cast<long>(count) * n * n * (n + m);
+  s21_kernels::ParallelFor(0, Blocks(count), work, [&](int from, int to) {
+    std::vector<double> lhs(static_cast<std::size_t>(n) * n * kLanes);
+    double det[kLanes];
+    for (int block = from; block < to; ++block) {
+      const int width = std::min(kLanes, count - block * kLanes);
+      const double *source = BlockData(a, block);
+      std::copy(source, source + lhs.size(), lhs.data());
+      Eliminate(lhs.data(), BlockData(result, block), n, m, width, true,
+                kEpsilon, det);
+      for (int l = 0; l < width; ++l) {
+        if (det[l] == 0.0) throw std::logic_error(message);
+      }
+    }
+  });
+}
+}  // namespace
+
+S21MatrixBatch::S21MatrixBatch() : S21MatrixBatch(0, 0, 0) {}
+
+S21MatrixBatch::S21MatrixBatch(int count, int rows, int cols)
+    : count_(count), rows_(rows), cols_(cols), data_(S21GetMemoryResource()) {
+  if (count < 0 || rows < 0 || cols < 0) {
+    throw std::length_error("S21MatrixBatch: negative batch size");
+  }
+  data_.resize(static_cast<std::size_t>(Blocks(count_)) * rows_ * cols_ *
+               kLanes);
+}
+
+// копия, как и у S21Matrix, берёт ресурс текущего потока
+S21MatrixBatch::S21MatrixBatch(const S21MatrixBatch &other)
+    : count_(other.count_),
+      rows_(other.rows_),
+      cols_(other.cols_),
+      data_(other.data_, S21GetMemoryResource()) {}
+
+int S21MatrixBatch::GetCount() const noexcept { return count_; }
+
+int S21MatrixBatch::GetRows() const noexcept { return rows_; }
+
+int S21MatrixBatch::GetCols() const noexcept { return cols_; }
+
+double *S21MatrixBatch::data() noexcept { return data_.data(); }
+
+const double *S21MatrixBatch::data() const noexcept { return data_.data(); }
+
+double &S21MatrixBatch::operator()(int index, int row, int col) & {
+  if (index < 0 || row < 0 || col < 0 || index >= count_ || row >= rows_ ||
+      col >= cols_) {
+    throw std::out_of_range("Index out of range");
+  }
+  return At(BlockData(*this, index / kLanes), cols_, row, col)[index % kLanes];
+}
+
+const double &S21MatrixBatch::operator()(int index, int row,
+                                         int col) const & {
+  return At(BlockData(*this, index / kLanes), cols_, row, col)[index % kLanes];
+}
+
+S21Matrix S21MatrixBatch::Get(int index) const {
+  if (index < 0 || index >= count_) {
+    throw std::out_of_range("Get: index out of range");
+  }
+  S21Matrix result(rows_, cols_);
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) result(i, j) = (*this)(index, i, j);
+  }
+  return result;
+}
+
+void S21MatrixBatch::Set(int index, const S21Matrix &matrix) {
+  if (index < 0 || index >= count_) {
+    throw std::out_of_range("Set: index out of range");
+  }
+  if (matrix.GetRows() != rows_ || matrix.GetCols() != cols_) {
+    throw std::logic_error("Set: incorrect matrix size");
+  }
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) (*this)(index, i, j) = matrix(i, j);
+  }
+}
+
+S21MatrixBatch S21BatchMul(const S21MatrixBatch &a, const S21MatrixBatch &b) {
+  if (a.GetCount() != b.GetCount() || a.GetCols() != b.GetRows()) {
+    throw std::logic_error("BatchMul: incorrect matrix size");
+  }
+  const int count = a.GetCount(), m = a.GetRows(), n = b.GetCols(),
+            k = a.GetCols();
+  S21MatrixBatch c(count, m, n);
+  const long work = static_cast<long>(count) * m * n * k;
+  const auto mul_add = s21_kernels::Simd().mul_add;
+  s21_kernels::ParallelFor(0, Blocks(count), work, [&](int from, int to) {
+    for (int block = from; block < to; ++block) {
+      const int width = std::min(kLanes, count - block * kLanes);
+      const double *lhs = BlockData(a, block);
+      const double *rhs = BlockData(b, block);
+      double *product = BlockData(c, block);
+      // i-p-j: строка p куска B проходится подряд
+      for (int i = 0; i < m; ++i) {
+        for (int p = 0; p < k; ++p) {
+          const double *value = At(lhs, k, i, p);
+          for (int j = 0; j < n; ++j) {
+            mul_add(At(product, n, i, j), value, At(rhs, n, p, j), width);
+          }
+        }
+      }
+    }
+  });
+  return c;
+}
+
+std::vector<double> S21BatchDeterminant(const S21MatrixBatch &a) {
+  CheckSquare(a, "BatchDeterminant: incorrect matrix size");
+  const int n = a.GetRows(), count = a.GetCount();
+  std::vector<double> result(count);
+  const long work = static_cast<long>(count) * n * n * n;
+  s21_kernels::ParallelFor(0, Blocks(count), work, [&](int from, int to) {
+    std::vector<double> lu(static_cast<std::size_t>(n) * n * kLanes);
+    for (int block = from; block < to; ++block) {
+      const int lane = block * kLanes;
+      const double *source = BlockData(a, block);
+      std::copy(source, source + lu.size(), lu.data());
+      // как в S21Matrix::Determinant, вырожденность - только точный ноль
+      Eliminate(lu.data(), nullptr, n, 0, std::min(kLanes, count - lane),
+                false, 0.0, &result[lane]);
+    }
+  });
+  return result;
+}
+
+S21MatrixBatch S21BatchInverse(const S21MatrixBatch &a) {
+  CheckSquare(a, "BatchInverse: incorrect matrix size");
+  const int n = a.GetRows(), count = a.GetCount();
+  S21MatrixBatch result(count, n, n);
+  for (int block = 0; block < Blocks(count); ++block) {
+    const int width = std::min(kLanes, count - block * kLanes);
+    for (int i = 0; i < n; ++i) {
+      double *cell = At(BlockData(result, block), n, i, i);
+      std::fill(cell, cell + width, 1.0);
+    }
+  }
+  GaussJordan(a, result, "BatchInverse: determinant must be non-zero");
+  return result;
+}
+
+S21MatrixBatch S21BatchSolve(const S21MatrixBatch &a, const S21MatrixBatch &b) {
+  CheckSquare(a, "BatchSolve: incorrect matrix size");
+  if (a.GetCount() != b.GetCount() || b.GetRows() != a.GetRows()) {
+    throw std::logic_error("BatchSolve: incorrect right-hand side size");
+  }
+  S21MatrixBatch result(b);
+  GaussJordan(a, result, "BatchSolve: matrix is singular");
+  return result;
+}
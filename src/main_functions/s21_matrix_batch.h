@@ -0,0 +1,58 @@
+#ifndef S21_MATRIX_BATCH_H_
+#define S21_MATRIX_BATCH_H_
+
+#include <memory_resource>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Партия из count матриц одного размера rows x cols в виде структуры
+// массивов, разбитой на куски по kLanes матриц: внутри куска элементы
+// (i, j) всех его матриц лежат подряд, сами куски - друг за другом.
+// Операции над партией идут векторными ядрами по матрицам куска,
+// а потоки делят партию по кускам. Буфер выделяется из
+// S21GetMemoryResource().
+class S21MatrixBatch {
+ public:
+  // матриц в куске: строка куска помещается в несколько кэш-линий,
+  // а весь кусок малых матриц - в L1/L2
+  static constexpr int kLanes = 64;
+
+ private:
+  int count_, rows_, cols_;
+  std::pmr::vector<double> data_;
+
+ public:
+  S21MatrixBatch();
+  S21MatrixBatch(int count, int rows, int cols);
+  S21MatrixBatch(const S21MatrixBatch &other);
+  S21MatrixBatch(S21MatrixBatch &&other) noexcept = default;
+  S21MatrixBatch &operator=(const S21MatrixBatch &other) = default;
+  S21MatrixBatch &operator=(S21MatrixBatch &&other) noexcept = default;
+
+  int GetCount() const noexcept;
+  int GetRows() const noexcept;
+  int GetCols() const noexcept;
+  // элемент (i, j) матрицы k лежит в data()[(k / kLanes * rows * cols +
+  // i * cols + j) * kLanes + k % kLanes]; хвост последнего куска - нули
+  double *data() noexcept;
+  const double *data() const noexcept;
+
+  // элемент (row, col) матрицы index
+  double &operator()(int index, int row, int col) &;
+  const double &operator()(int index, int row, int col) const &;
+  // копия матрицы index и запись матрицы на её место
+  S21Matrix Get(int index) const;
+  void Set(int index, const S21Matrix &matrix);
+};
+
+// C[k] = A[k] * B[k] для всех k
+S21MatrixBatch S21BatchMul(const S21MatrixBatch &a, const S21MatrixBatch &b);
+// определители (0 у вырожденных матриц)
+std::vector<double> S21BatchDeterminant(const S21MatrixBatch &a);
+// обратные матрицы; вырожденная матрица в партии - исключение
+S21MatrixBatch S21BatchInverse(const S21MatrixBatch &a);
+// решения A[k] * X[k] = B[k] для всех столбцов B[k] сразу
+S21MatrixBatch S21BatchSolve(const S21MatrixBatch &a, const S21MatrixBatch &b);
+
+#endif  // S21_MATRIX_BATCH_H_
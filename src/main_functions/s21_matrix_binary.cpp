@@ -0,0 +1,386 @@
+#include "s21_matrix_binary.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <climits>    // INT_MAX
+#include <cstring>    // std::memcpy, std::memcmp
+#include <stdexcept>  // logic_error, runtime_error
+#include <utility>    // std::exchange
+#include <vector>
+
+namespace {
+constexpr char kMagic[8] = {'S', '2', '1', 'M', 'A', 'T', 'R', 'X'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::uint64_t kFnvOffset = 14695981039346656037ull;
+constexpr std::uint64_t kFnvPrime = 1099511628211ull;
+
+struct Header {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t type;
+  std::uint32_t element_size;
+  std::uint32_t layout;
+  std::int64_t rows;
+  std::int64_t cols;
+  std::uint64_t checksum;
+  char reserved[16];
+};
+static_assert(sizeof(Header) == 64, "header must stay 64 bytes");
+
+std::uint32_t Word(const unsigned char *bytes, std::size_t index) {
+  std::uint32_t word;
+  std::memcpy(&word, bytes + index * 4, sizeof(word));
+  return word;
+}
+
+void Mix(std::uint64_t &lane, std::uint32_t word) {
+  lane = (lane ^ word) * kFnvPrime;
+}
+
+std::size_t ElementSize(S21DataType type) {
+  switch (type) {
+    case S21DataType::kFloat:
+      return sizeof(float);
+    case S21DataType::kDouble:
+      return sizeof(double);
+    case S21DataType::kLongDouble:
+      return sizeof(long double);
+    case S21DataType::kComplexDouble:
+      return sizeof(std::complex<double>);
+  }
+  return 0;
+}
+
+// заголовок своего формата с размером элемента этой машины
+void CheckHeader(const Header &header, const std::string &path) {
+  const auto type = static_cast<S21DataType>(header.type);
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion || ElementSize(type) == 0 ||
+      header.layout > static_cast<std::uint32_t>(S21Layout::kColMajor) ||
+      header.rows < 0 || header.cols < 0 || header.rows > INT_MAX ||
+      header.cols > INT_MAX) {
+    throw std::runtime_error("LoadMatrix: " + path +
+                             " is not an S21 matrix file");
+  }
+  if (header.element_size != ElementSize(type)) {
+    throw std::runtime_error("LoadMatrix: " + path +
+                             " was written with another element size");
+  }
+}
+
+void CheckType(const Header &header, S21DataType type) {
+  if (static_cast<S21DataType>(header.type) != type) {
+    throw std::logic_error("LoadMatrix: incorrect element type");
+  }
+}
+
+// линий и элементов в линии при порядке layout
+int Lines(int rows, int cols, S21Layout layout) {
+  return layout == S21Layout::kRowMajor ? rows : cols;
+}
+
+int Length(int rows, int cols, S21Layout layout) {
+  return layout == S21Layout::kRowMajor ? cols : rows;
+}
+
+// закрывает файл и при выходе по исключению
+struct FileCloser {
+  std::FILE *file;
+  ~FileCloser() {
+    if (file) std::fclose(file);
+  }
+};
+}  // namespace
+
+namespace s21_kernels {
+
+Checksum::Checksum()
+    : lanes_{kFnvOffset, kFnvOffset ^ 1, kFnvOffset ^ 2, kFnvOffset ^ 3},
+      words_(0) {}
+
+void Checksum::Update(const void *data, std::size_t bytes) {
+  const auto *source = static_cast<const unsigned char *>(data);
+  const std::size_t count = bytes / 4;
+  std::size_t i = 0;
+  // до начала очередной четвёрки слов
+  for (; i < count && (words_ + i) % 4 != 0; ++i) {
+    Mix(lanes_[(words_ + i) % 4], Word(source, i));
+  }
+  std::uint64_t a = lanes_[0], b = lanes_[1], c = lanes_[2], d = lanes_[3];
+  for (; i + 4 <= count; i += 4) {
+    Mix(a, Word(source, i));
+    Mix(b, Word(source, i + 1));
+    Mix(c, Word(source, i + 2));
+    Mix(d, Word(source, i + 3));
+  }
+  lanes_[0] = a;
+  lanes_[1] = b;
+  lanes_[2] = c;
+  lanes_[3] = d;
+  for (; i < count; ++i) Mix(lanes_[(words_ + i) % 4], Word(source, i));
+  words_ += count;
+}
+
+std::uint64_t Checksum::Value() const noexcept {
+  std::uint64_t hash = kFnvOffset;
+  for (std::uint64_t lane : lanes_) hash = (hash ^ lane) * kFnvPrime;
+  return (hash ^ words_) * kFnvPrime;
+}
+
+}  // namespace s21_kernels
+
+template <typename T>
+void S21SaveMatrix(const std::string &path, const S21BasicMatrix<T> &matrix,
+                   S21Layout layout) {
+  S21BasicMatrixWriter<T> writer(path, matrix.GetRows(), matrix.GetCols(),
+                                 layout);
+  writer.Write(matrix.View());
+  writer.Close();
+}
+
+template <typename T>
+S21BasicMatrix<T> S21LoadMatrix(const std::string &path) {
+  FileCloser closer{std::fopen(path.c_str(), "rb")};
+  if (!closer.file) {
+    throw std::runtime_error("LoadMatrix: can not open " + path);
+  }
+  Header header;
+  if (std::fread(&header, sizeof(header), 1, closer.file) != 1) {
+    throw std::runtime_error("LoadMatrix: " + path +
+                             " is not an S21 matrix file");
+  }
+  CheckHeader(header, path);
+  CheckType(header, kS21DataType<T>);
+  const auto layout = static_cast<S21Layout>(header.layout);
+  const int rows = static_cast<int>(header.rows);
+  const int cols = static_cast<int>(header.cols);
+  // файл по столбцам читается как транспонированная матрица
+  S21BasicMatrix<T> result(Lines(rows, cols, layout),
+                           Length(rows, cols, layout));
+  s21_kernels::Checksum checksum;
+  const int length = result.GetCols();
+  for (int i = 0; i < result.GetRows(); ++i) {
+    T *line = result.data() + static_cast<long>(i) * result.stride();
+    if (std::fread(line, sizeof(T), length, closer.file) !=
+        static_cast<std::size_t>(length)) {
+      throw std::runtime_error("LoadMatrix: " + path + " is truncated");
+    }
+    checksum.Update(line, sizeof(T) * length);
+  }
+  if (checksum.Value() != header.checksum) {
+    throw std::runtime_error("LoadMatrix: checksum mismatch in " + path);
+  }
+  if (layout == S21Layout::kColMajor) result = result.Transpose();
+  return result;
+}
+
+S21MappedMatrix::S21MappedMatrix(const std::string &path, bool verify)
+    : address_(nullptr),
+      length_(0),
+      rows_(0),
+      cols_(0),
+      type_(S21DataType::kDouble),
+      layout_(S21Layout::kRowMajor) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("MappedMatrix: can not open " + path);
+  }
+  struct stat info;
+  if (::fstat(fd, &info) != 0 ||
+      static_cast<std::size_t>(info.st_size) < sizeof(Header)) {
+    ::close(fd);
+    throw std::runtime_error("MappedMatrix: " + path +
+                             " is not an S21 matrix file");
+  }
+  length_ = static_cast<std::size_t>(info.st_size);
+  void *address = ::mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+  // отображение держит файл само, дескриптор больше не нужен
+  ::close(fd);
+  if (address == MAP_FAILED) {
+    throw std::runtime_error("MappedMatrix: can not map " + path);
+  }
+  address_ = address;
+  try {
+    Header header;
+    std::memcpy(&header, address_, sizeof(header));
+    CheckHeader(header, path);
+    rows_ = static_cast<int>(header.rows);
+    cols_ = static_cast<int>(header.cols);
+    type_ = static_cast<S21DataType>(header.type);
+    layout_ = static_cast<S21Layout>(header.layout);
+    // сравнение делением: произведение размеров может переполниться
+    const std::size_t elements =
+        (length_ - sizeof(Header)) / header.element_size;
+    if (cols_ != 0 && static_cast<std::size_t>(rows_) > elements / cols_) {
+      throw std::runtime_error("MappedMatrix: " + path + " is truncated");
+    }
+    const std::size_t payload =
+        static_cast<std::size_t>(rows_) * cols_ * header.element_size;
+    if (verify) {
+      s21_kernels::Checksum checksum;
+      checksum.Update(static_cast<const char *>(address_) + sizeof(Header),
+                      payload);
+      if (checksum.Value() != header.checksum) {
+        throw std::runtime_error("MappedMatrix: checksum mismatch in " +
+                                 path);
+      }
+    }
+  } catch (...) {
+    ::munmap(address_, length_);
+    throw;
+  }
+}
+
+S21MappedMatrix::S21MappedMatrix(S21MappedMatrix &&other) noexcept
+    : address_(std::exchange(other.address_, nullptr)),
+      length_(std::exchange(other.length_, 0)),
+      rows_(std::exchange(other.rows_, 0)),
+      cols_(std::exchange(other.cols_, 0)),
+      type_(other.type_),
+      layout_(other.layout_) {}
+
+S21MappedMatrix &S21MappedMatrix::operator=(S21MappedMatrix &&other) noexcept {
+  if (this != &other) {
+    if (address_) ::munmap(address_, length_);
+    address_ = std::exchange(other.address_, nullptr);
+    length_ = std::exchange(other.length_, 0);
+    rows_ = std::exchange(other.rows_, 0);
+    cols_ = std::exchange(other.cols_, 0);
+    type_ = other.type_;
+    layout_ = other.layout_;
+  }
+  return *this;
+}
+
+S21MappedMatrix::~S21MappedMatrix() {
+  if (address_) ::munmap(address_, length_);
+}
+
+int S21MappedMatrix::GetRows() const noexcept { return rows_; }
+
+int S21MappedMatrix::GetCols() const noexcept { return cols_; }
+
+S21DataType S21MappedMatrix::GetType() const noexcept { return type_; }
+
+S21Layout S21MappedMatrix::GetLayout() const noexcept { return layout_; }
+
+template <typename T>
+S21BasicMatrixView<const T> S21MappedMatrix::View() const {
+  if (type_ != kS21DataType<T>) {
+    throw std::logic_error("MappedMatrix: incorrect element type");
+  }
+  const T *data = reinterpret_cast<const T *>(
+      static_cast<const char *>(address_) + sizeof(Header));
+  if (layout_ == S21Layout::kColMajor) {
+    return {data, rows_, cols_, 1, rows_};
+  }
+  return {data, rows_, cols_, cols_};
+}
+
+template <typename T>
+S21BasicMatrixWriter<T>::S21BasicMatrixWriter(const std::string &path,
+                                              int rows, int cols,
+                                              S21Layout layout)
+    : file_(nullptr), rows_(rows), cols_(cols), layout_(layout), written_(0) {
+  if (rows < 0 || cols < 0) {
+    throw std::length_error("MatrixWriter: negative matrix size");
+  }
+  file_ = std::fopen(path.c_str(), "wb");
+  if (!file_) {
+    throw std::runtime_error("MatrixWriter: can not open " + path);
+  }
+  // место под заголовок; сам он пишется в Close()
+  const Header empty{};
+  if (std::fwrite(&empty, sizeof(empty), 1, file_) != 1) {
+    std::fclose(file_);
+    throw std::runtime_error("MatrixWriter: can not write " + path);
+  }
+}
+
+template <typename T>
+S21BasicMatrixWriter<T>::~S21BasicMatrixWriter() {
+  if (file_) std::fclose(file_);
+}
+
+template <typename T>
+void S21BasicMatrixWriter<T>::Write(const T *line) {
+  if (!file_ || written_ == Lines(rows_, cols_, layout_)) {
+    throw std::logic_error("MatrixWriter: all lines are already written");
+  }
+  const int length = Length(rows_, cols_, layout_);
+  if (std::fwrite(line, sizeof(T), length, file_) !=
+      static_cast<std::size_t>(length)) {
+    throw std::runtime_error("MatrixWriter: write failed");
+  }
+  checksum_.Update(line, sizeof(T) * length);
+  ++written_;
+}
+
+template <typename T>
+void S21BasicMatrixWriter<T>::Write(S21BasicMatrixView<const T> lines) {
+  // линии файла - строки source
+  const S21BasicMatrixView<const T> source =
+      layout_ == S21Layout::kRowMajor ? lines : lines.Transposed();
+  if (source.GetCols() != Length(rows_, cols_, layout_)) {
+    throw std::logic_error("MatrixWriter: incorrect line length");
+  }
+  std::vector<T> line;
+  if (source.ColStride() != 1) line.resize(source.GetCols());
+  for (int i = 0; i < source.GetRows(); ++i) {
+    if (line.empty()) {
+      Write(&source(i, 0));
+    } else {
+      for (int j = 0; j < source.GetCols(); ++j) line[j] = source(i, j);
+      Write(line.data());
+    }
+  }
+}
+
+template <typename T>
+void S21BasicMatrixWriter<T>::Close() {
+  if (!file_) return;
+  FileCloser closer{std::exchange(file_, nullptr)};
+  if (written_ != Lines(rows_, cols_, layout_)) {
+    throw std::logic_error("MatrixWriter: not all lines are written");
+  }
+  Header header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.type = static_cast<std::uint32_t>(kS21DataType<T>);
+  header.element_size = sizeof(T);
+  header.layout = static_cast<std::uint32_t>(layout_);
+  header.rows = rows_;
+  header.cols = cols_;
+  header.checksum = checksum_.Value();
+  if (std::fseek(closer.file, 0, SEEK_SET) != 0 ||
+      std::fwrite(&header, sizeof(header), 1, closer.file) != 1 ||
+      std::fclose(std::exchange(closer.file, nullptr)) != 0) {
+    throw std::runtime_error("MatrixWriter: write failed");
+  }
+}
+
+template class S21BasicMatrixWriter<float>;
+template class S21BasicMatrixWriter<double>;
+template class S21BasicMatrixWriter<long double>;
+template class S21BasicMatrixWriter<std::complex<double>>;
+
+template void S21SaveMatrix(const std::string &, const S21MatrixF &,
+                            S21Layout);
+template void S21SaveMatrix(const std::string &, const S21Matrix &,
+                            S21Layout);
+template void S21SaveMatrix(const std::string &, const S21MatrixLD &,
+                            S21Layout);
+template void S21SaveMatrix(const std::string &, const S21MatrixC &,
+                            S21Layout);
+template S21MatrixF S21LoadMatrix<float>(const std::string &);
+template S21Matrix S21LoadMatrix<double>(const std::string &);
+template S21MatrixLD S21LoadMatrix<long double>(const std::string &);
+template S21MatrixC S21LoadMatrix<std::complex<double>>(const std::string &);
+template S21BasicMatrixView<const float> S21MappedMatrix::View() const;
+template S21BasicMatrixView<const double> S21MappedMatrix::View() const;
+template S21BasicMatrixView<const long double> S21MappedMatrix::View() const;
+template S21BasicMatrixView<const std::complex<double>>
+S21MappedMatrix::View() const;
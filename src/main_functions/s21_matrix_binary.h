@@ -0,0 +1,136 @@
+#ifndef S21_MATRIX_BINARY_H_
+#define S21_MATRIX_BINARY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "s21_matrix_oop.h"
+
+// Двоичный формат матрицы (.s21m): заголовок из 64 байт и сразу за ним
+// элементы подряд, строка за строкой (kRowMajor) или столбец за столбцом
+// (kColMajor), без промежутков. Заголовок:
+//   0  char[8]   "S21MATRX"
+//   8  uint32    версия формата (1)
+//   12 uint32    тип элементов S21DataType
+//   16 uint32    размер элемента в байтах
+//   20 uint32    порядок S21Layout
+//   24 int64     строк
+//   32 int64     столбцов
+//   40 uint64    контрольная сумма элементов
+//   48 char[16]  нули
+// Числа - в порядке байт машины, записавшей файл; смещение элементов
+// кратно 64, поэтому отображённые в память данные выровнены.
+enum class S21DataType : std::uint32_t {
+  kFloat = 1,
+  kDouble = 2,
+  kLongDouble = 3,
+  kComplexDouble = 4
+};
+
+// тип элементов S21BasicMatrix<T> в заголовке
+template <typename T>
+constexpr S21DataType kS21DataType = S21DataType::kDouble;
+template <>
+constexpr S21DataType kS21DataType<float> = S21DataType::kFloat;
+template <>
+constexpr S21DataType kS21DataType<long double> = S21DataType::kLongDouble;
+template <>
+constexpr S21DataType kS21DataType<std::complex<double>> =
+    S21DataType::kComplexDouble;
+
+namespace s21_kernels {
+// Контрольная сумма элементов: FNV-1a по 32-битным словам в четыре
+// независимые цепочки (слово i - в цепочку i % 4), чтобы проверка
+// не упиралась в задержку умножения. Данные можно подавать кусками
+// любой длины, кратной 4 байтам.
+class Checksum {
+ private:
+  std::uint64_t lanes_[4];
+  std::uint64_t words_;
+
+ public:
+  Checksum();
+  void Update(const void *data, std::size_t bytes);
+  std::uint64_t Value() const noexcept;
+};
+}  // namespace s21_kernels
+
+// Запись и чтение целиком. Ошибки ввода-вывода, чужой или повреждённый
+// файл (в том числе несовпадение контрольной суммы) - std::runtime_error,
+// другой тип элементов - std::logic_error. Матрица по столбцам при
+// чтении переставляется в обычную.
+template <typename T>
+void S21SaveMatrix(const std::string &path, const S21BasicMatrix<T> &matrix,
+                   S21Layout layout = S21Layout::kRowMajor);
+template <typename T>
+S21BasicMatrix<T> S21LoadMatrix(const std::string &path);
+
+// Файл, отображённый в память только для чтения: элементы не копируются
+// и подгружаются системой по мере обращения, поэтому файл может быть
+// больше оперативной памяти. Виды действительны, пока жив объект.
+class S21MappedMatrix {
+ private:
+  void *address_;
+  std::size_t length_;
+  int rows_, cols_;
+  S21DataType type_;
+  S21Layout layout_;
+
+ public:
+  // verify - сверить контрольную сумму (читает весь файл)
+  explicit S21MappedMatrix(const std::string &path, bool verify = true);
+  S21MappedMatrix(const S21MappedMatrix &) = delete;
+  S21MappedMatrix(S21MappedMatrix &&other) noexcept;
+  S21MappedMatrix &operator=(const S21MappedMatrix &) = delete;
+  S21MappedMatrix &operator=(S21MappedMatrix &&other) noexcept;
+  ~S21MappedMatrix();
+
+  int GetRows() const noexcept;
+  int GetCols() const noexcept;
+  S21DataType GetType() const noexcept;
+  S21Layout GetLayout() const noexcept;
+  // вид на элементы; для файла по столбцам - с перестановкой шагов
+  template <typename T>
+  S21BasicMatrixView<const T> View() const;
+};
+
+// Потоковая запись матрицы rows x cols по линиям (строкам для kRowMajor,
+// столбцам для kColMajor): в памяти держится только буфер файла, поэтому
+// так пишутся матрицы больше оперативной памяти. Заголовок пишется
+// в Close() после проверки, что записаны все линии, поэтому
+// незаконченный файл не читается как матрица.
+template <typename T>
+class S21BasicMatrixWriter {
+ private:
+  std::FILE *file_;
+  int rows_, cols_;
+  S21Layout layout_;
+  // записано линий
+  long written_;
+  s21_kernels::Checksum checksum_;
+
+ public:
+  S21BasicMatrixWriter(const std::string &path, int rows, int cols,
+                       S21Layout layout = S21Layout::kRowMajor);
+  S21BasicMatrixWriter(const S21BasicMatrixWriter &) = delete;
+  S21BasicMatrixWriter &operator=(const S21BasicMatrixWriter &) = delete;
+  ~S21BasicMatrixWriter();
+
+  // очередная линия из cols (rows для kColMajor) элементов
+  void Write(const T *line);
+  // очередные линии из вида: его строки для kRowMajor, столбцы для
+  // kColMajor
+  void Write(S21BasicMatrixView<const T> lines);
+  void Close();
+};
+
+using S21MatrixWriter = S21BasicMatrixWriter<double>;
+
+extern template class S21BasicMatrixWriter<float>;
+extern template class S21BasicMatrixWriter<double>;
+extern template class S21BasicMatrixWriter<long double>;
+extern template class S21BasicMatrixWriter<std::complex<double>>;
+
+#endif  // S21_MATRIX_BINARY_H_
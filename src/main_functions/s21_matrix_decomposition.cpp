@@ -0,0 +1,232 @@
+#include "s21_matrix_decomposition.h"
+
+#include <algorithm>  // std::copy
+#include <cmath>      // std::abs, std::sqrt
+#include <stdexcept>  // logic_error
+
+#include "s21_matrix_kernels.h"
+
+namespace {
+S21Matrix Identity(int n) {
+  S21Matrix result(n, n);
+  for (int i = 0; i < n; ++i) result(i, i) = 1;
+  return result;
+}
+}  // namespace
+
+S21LU::S21LU(const S21Matrix &matrix) : lu_(matrix), sign_(0) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::logic_error("S21LU: incorrect matrix size");
+  }
+  pivots_.resize(lu_.GetRows());
+  sign_ = s21_kernels::LuFactorize(lu_.data(), lu_.GetRows(), lu_.stride(),
+                                   pivots_.data(), 0.0);
+}
+
+int S21LU::GetSize() const noexcept { return lu_.GetRows(); }
+
+bool S21LU::IsSingular() const noexcept {
+  bool singular = sign_ == 0;
+  for (int i = 0; i < lu_.GetRows() && !singular; ++i) {
+    singular = std::abs(lu_(i, i)) < EPSILON;
+  }
+  return singular;
+}
+
+void S21LU::CheckSolvable(int rhs_rows) const {
+  if (rhs_rows != lu_.GetRows()) {
+    throw std::logic_error("S21LU: incorrect right-hand side size");
+  }
+  if (IsSingular()) {
+    throw std::logic_error("S21LU: matrix is singular");
+  }
+}
+
+S21Matrix S21LU::Solve(const S21Matrix &b) const {
+  CheckSolvable(b.GetRows());
+  S21Matrix x(b);
+  const int n = lu_.GetRows();
+  s21_kernels::ApplyPivots(pivots_.data(), n, x.data(), x.stride(),
+                           x.GetCols());
+  s21_kernels::SolveLower(lu_.data(), n, lu_.stride(), true, x.data(),
+                          x.stride(), x.GetCols());
+  s21_kernels::SolveUpper(lu_.data(), n, lu_.stride(), x.data(), x.stride(),
+                          x.GetCols());
+  return x;
+}
+
+double S21LU::Determinant() const noexcept {
+  double det = sign_;
+  for (int i = 0; i < lu_.GetRows() && det != 0; ++i) det *= lu_(i, i);
+  return det;
+}
+
+S21Matrix S21LU::Inverse() const { return Solve(Identity(lu_.GetRows())); }
+
+S21Cholesky::S21Cholesky(const S21Matrix &matrix)
+    : l_(matrix.GetRows(), matrix.GetCols()) {
+  const int n = matrix.GetRows();
+  if (n != matrix.GetCols()) {
+    throw std::logic_error("S21Cholesky: incorrect matrix size");
+  }
+  for (int j = 0; j < n; ++j) {
+    const double *row_j = l_.data() + static_cast<long>(j) * l_.stride();
+    double diagonal = matrix(j, j);
+    for (int k = 0; k < j; ++k) diagonal -= row_j[k] * row_j[k];
+    if (diagonal < EPSILON) {
+      throw std::logic_error("S21Cholesky: matrix is not positive definite");
+    }
+    const double root = std::sqrt(diagonal);
+    l_(j, j) = root;
+    for (int i = j + 1; i < n; ++i) {
+      if (std::abs(matrix(i, j) - matrix(j, i)) > EPSILON) {
+        throw std::logic_error("S21Cholesky: matrix is not symmetric");
+      }
+      const double *row_i = l_.data() + static_cast<long>(i) * l_.stride();
+      double value = matrix(i, j);
+      for (int k = 0; k < j; ++k) value -= row_i[k] * row_j[k];
+      l_(i, j) = value / root;
+    }
+  }
+}
+
+int S21Cholesky::GetSize() const noexcept { return l_.GetRows(); }
+
+S21Matrix S21Cholesky::Solve(const S21Matrix &b) const {
+  const int n = l_.GetRows();
+  if (b.GetRows() != n) {
+    throw std::logic_error("S21Cholesky: incorrect right-hand side size");
+  }
+  S21Matrix x(b);
+  const int cols = x.GetCols();
+  s21_kernels::SolveLower(l_.data(), n, l_.stride(), false, x.data(),
+                          x.stride(), cols);
+  // обратный ход по L^T: элементы L^T(i, k) = L(k, i)
+  for (int i = n - 1; i >= 0; --i) {
+    double *row_i = x.data() + static_cast<long>(i) * x.stride();
+    for (int k = i + 1; k < n; ++k) {
+      const double factor = l_(k, i);
+      const double *row_k = x.data() + static_cast<long>(k) * x.stride();
+      for (int j = 0; j < cols; ++j) row_i[j] -= factor * row_k[j];
+    }
+    const double inverse = 1.0 / l_(i, i);
+    for (int j = 0; j < cols; ++j) row_i[j] *= inverse;
+  }
+  return x;
+}
+
+double S21Cholesky::Determinant() const noexcept {
+  double det = 1;
+  for (int i = 0; i < l_.GetRows(); ++i) det *= l_(i, i) * l_(i, i);
+  return det;
+}
+
+S21Matrix S21Cholesky::Inverse() const {
+  return Solve(Identity(l_.GetRows()));
+}
+
+S21QR::S21QR(const S21Matrix &matrix) : qr_(matrix), tau_(matrix.GetCols()) {
+  const int m = qr_.GetRows();
+  const int n = qr_.GetCols();
+  if (m < n) {
+    throw std::logic_error("S21QR: matrix must have rows >= cols");
+  }
+  double *a = qr_.data();
+  const long lda = qr_.stride();
+  std::vector<double> w(n);
+  for (int k = 0; k < n; ++k) {
+    double norm = 0;
+    for (int i = k; i < m; ++i) norm += a[i * lda + k] * a[i * lda + k];
+    norm = std::sqrt(norm);
+    tau_[k] = 0;
+    if (norm == 0) continue;
+    // H = I - tau * v * v^T, v(k) = 1, R(k, k) = beta
+    const double alpha = a[k * lda + k];
+    const double beta = alpha > 0 ? -norm : norm;
+    tau_[k] = (beta - alpha) / beta;
+    const double scale = 1.0 / (alpha - beta);
+    for (int i = k + 1; i < m; ++i) a[i * lda + k] *= scale;
+    a[k * lda + k] = beta;
+    // w = v^T * A(k:, k+1:), обход по строкам
+    std::copy(a + k * lda + k + 1, a + k * lda + n, w.begin() + k + 1);
+    for (int i = k + 1; i < m; ++i) {
+      const double v = a[i * lda + k];
+      const double *row_i = a + i * lda;
+      for (int j = k + 1; j < n; ++j) w[j] += v * row_i[j];
+    }
+    for (int j = k + 1; j < n; ++j) {
+      w[j] *= tau_[k];
+      a[k * lda + j] -= w[j];
+    }
+    for (int i = k + 1; i < m; ++i) {
+      const double v = a[i * lda + k];
+      double *row_i = a + i * lda;
+      for (int j = k + 1; j < n; ++j) row_i[j] -= v * w[j];
+    }
+  }
+}
+
+int S21QR::GetRows() const noexcept { return qr_.GetRows(); }
+
+int S21QR::GetCols() const noexcept { return qr_.GetCols(); }
+
+bool S21QR::IsFullRank() const noexcept {
+  bool full = true;
+  for (int i = 0; i < qr_.GetCols() && full; ++i) {
+    full = std::abs(qr_(i, i)) >= EPSILON;
+  }
+  return full;
+}
+
+S21Matrix S21QR::Solve(const S21Matrix &b) const {
+  const int m = qr_.GetRows();
+  const int n = qr_.GetCols();
+  if (b.GetRows() != m) {
+    throw std::logic_error("S21QR: incorrect right-hand side size");
+  }
+  if (!IsFullRank()) {
+    throw std::logic_error("S21QR: matrix is rank deficient");
+  }
+  S21Matrix y(b);
+  const int cols = y.GetCols();
+  const long ldy = y.stride();
+  std::vector<double> w(cols);
+  // y = Q^T * b, отражения применяются по порядку
+  for (int k = 0; k < n; ++k) {
+    if (tau_[k] == 0) continue;
+    std::copy(y.data() + k * ldy, y.data() + k * ldy + cols, w.begin());
+    for (int i = k + 1; i < m; ++i) {
+      const double v = qr_(i, k);
+      const double *row_i = y.data() + i * ldy;
+      for (int j = 0; j < cols; ++j) w[j] += v * row_i[j];
+    }
+    for (int j = 0; j < cols; ++j) w[j] *= tau_[k];
+    for (int i = k; i < m; ++i) {
+      const double v = i == k ? 1.0 : qr_(i, k);
+      double *row_i = y.data() + i * ldy;
+      for (int j = 0; j < cols; ++j) row_i[j] -= v * w[j];
+    }
+  }
+  s21_kernels::SolveUpper(qr_.data(), n, qr_.stride(), y.data(), ldy, cols);
+  y.SetRows(n);
+  return y;
+}
+
+double S21QR::Determinant() const {
+  if (qr_.GetRows() != qr_.GetCols()) {
+    throw std::logic_error("S21QR: incorrect matrix size");
+  }
+  double det = 1;
+  for (int k = 0; k < qr_.GetCols(); ++k) {
+    // каждое нетривиальное отражение меняет знак
+    det *= tau_[k] == 0 ? qr_(k, k) : -qr_(k, k);
+  }
+  return det;
+}
+
+S21Matrix S21QR::Inverse() const {
+  if (qr_.GetRows() != qr_.GetCols()) {
+    throw std::logic_error("S21QR: incorrect matrix size");
+  }
+  return Solve(Identity(qr_.GetRows()));
+}
@@ -0,0 +1,66 @@
+#ifndef S21_MATRIX_DECOMPOSITION_H_
+#define S21_MATRIX_DECOMPOSITION_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// LU-разложение P * A = L * U с частичным выбором ведущего элемента.
+// Разложение строится один раз, Solve/Determinant/Inverse используют
+// сохранённые множители.
+class S21LU {
+ private:
+  S21Matrix lu_;
+  std::vector<int> pivots_;
+  int sign_;
+  const double EPSILON = 1e-7;
+  void CheckSolvable(int rhs_rows) const;
+
+ public:
+  explicit S21LU(const S21Matrix &matrix);
+
+  int GetSize() const noexcept;
+  bool IsSingular() const noexcept;
+  // решение A * X = B для всех столбцов B сразу
+  S21Matrix Solve(const S21Matrix &b) const;
+  double Determinant() const noexcept;
+  S21Matrix Inverse() const;
+};
+
+// разложение Холецкого A = L * L^T для симметричных положительно
+// определённых матриц
+class S21Cholesky {
+ private:
+  S21Matrix l_;
+  const double EPSILON = 1e-7;
+
+ public:
+  explicit S21Cholesky(const S21Matrix &matrix);
+
+  int GetSize() const noexcept;
+  S21Matrix Solve(const S21Matrix &b) const;
+  double Determinant() const noexcept;
+  S21Matrix Inverse() const;
+};
+
+// QR-разложение отражениями Хаусхолдера для матриц rows >= cols;
+// Solve возвращает решение задачи наименьших квадратов
+class S21QR {
+ private:
+  // R на диагонали и выше, векторы отражений ниже диагонали
+  S21Matrix qr_;
+  std::vector<double> tau_;
+  const double EPSILON = 1e-7;
+
+ public:
+  explicit S21QR(const S21Matrix &matrix);
+
+  int GetRows() const noexcept;
+  int GetCols() const noexcept;
+  bool IsFullRank() const noexcept;
+  S21Matrix Solve(const S21Matrix &b) const;
+  double Determinant() const;
+  S21Matrix Inverse() const;
+};
+
+#endif  // S21_MATRIX_DECOMPOSITION_H_
@@ -0,0 +1,147 @@
+#ifndef S21_MATRIX_EXPR_H_
+#define S21_MATRIX_EXPR_H_
+
+#include <stdexcept>
+#include <type_traits>
+
+template <typename T>
+class S21BasicMatrix;
+
+// Базовый класс (CRTP) ленивых поэлементных выражений. Операторы +, -
+// и умножение на число только строят дерево выражения, а вычисляется
+// оно одним проходом прямо в матрицу-приёмник при создании S21Matrix
+// или присваивании, без промежуточных матриц.
+// Узлы ссылаются на матрицы-операнды, поэтому выражение нельзя
+// сохранять (например, в auto) дольше полного выражения. Тип элементов
+// узла - E::value_type; смешивать в одном выражении разные типы нельзя.
+template <typename E>
+class S21MatrixExpr {
+ public:
+  const E &Self() const noexcept { return static_cast<const E &>(*this); }
+  int GetRows() const noexcept { return Self().GetRows(); }
+  int GetCols() const noexcept { return Self().GetCols(); }
+};
+
+namespace s21_expr {
+
+template <typename T>
+constexpr bool kIsExpr = std::is_base_of<S21MatrixExpr<T>, T>::value;
+
+template <typename T>
+constexpr bool kIsMatrix = false;
+template <typename T>
+constexpr bool kIsMatrix<S21BasicMatrix<T>> = true;
+
+// матрицы хранятся по ссылке, вложенные узлы - по значению
+template <typename E>
+using Operand = std::conditional_t<kIsMatrix<E>, const E &, const E>;
+
+// Читает ли выражение память [begin, end) приёмника. Матрица-лист либо
+// сама приёмник (элемент читается до записи), либо с ним не пересекается;
+// виды и узлы отвечают сами.
+template <typename E>
+bool Aliases(const E &expr, const void *begin, const void *end) noexcept {
+  if constexpr (kIsMatrix<E>) {
+    return false;
+  } else {
+    return expr.Aliases(begin, end);
+  }
+}
+
+struct Plus {
+  template <typename T>
+  static T Apply(T lhs, T rhs) noexcept {
+    return lhs + rhs;
+  }
+};
+
+struct Minus {
+  template <typename T>
+  static T Apply(T lhs, T rhs) noexcept {
+    return lhs - rhs;
+  }
+};
+
+template <typename L, typename R, typename Op>
+class Binary : public S21MatrixExpr<Binary<L, R, Op>> {
+  static_assert(std::is_same<typename L::value_type,
+                             typename R::value_type>::value,
+                "S21MatrixExpr: operands have different element types");
+
+ private:
+  Operand<L> lhs_;
+  Operand<R> rhs_;
+
+ public:
+  using value_type = typename L::value_type;
+  Binary(const L &lhs, const R &rhs) : lhs_(lhs), rhs_(rhs) {}
+  int GetRows() const noexcept { return lhs_.GetRows(); }
+  int GetCols() const noexcept { return lhs_.GetCols(); }
+  value_type operator()(int row, int col) const {
+    return Op::template Apply<value_type>(lhs_(row, col), rhs_(row, col));
+  }
+  bool Aliases(const void *begin, const void *end) const noexcept {
+    return s21_expr::Aliases(lhs_, begin, end) ||
+           s21_expr::Aliases(rhs_, begin, end);
+  }
+};
+
+template <typename E>
+class Scaled : public S21MatrixExpr<Scaled<E>> {
+ public:
+  using value_type = typename E::value_type;
+
+ private:
+  Operand<E> expr_;
+  value_type factor_;
+
+ public:
+  Scaled(const E &expr, value_type factor) : expr_(expr), factor_(factor) {}
+  int GetRows() const noexcept { return expr_.GetRows(); }
+  int GetCols() const noexcept { return expr_.GetCols(); }
+  value_type operator()(int row, int col) const {
+    return expr_(row, col) * factor_;
+  }
+  bool Aliases(const void *begin, const void *end) const noexcept {
+    return s21_expr::Aliases(expr_, begin, end);
+  }
+};
+
+template <typename L, typename R>
+void CheckSameSize(const S21MatrixExpr<L> &lhs, const S21MatrixExpr<R> &rhs,
+                   const char *message) {
+  if (lhs.GetRows() != rhs.GetRows() || lhs.GetCols() != rhs.GetCols()) {
+    throw std::logic_error(message);
+  }
+}
+
+}  // namespace s21_expr
+
+template <typename L, typename R>
+s21_expr::Binary<L, R, s21_expr::Plus> operator+(
+    const S21MatrixExpr<L> &lhs, const S21MatrixExpr<R> &rhs) {
+  s21_expr::CheckSameSize(lhs, rhs, "operator+: Incorrect matrix size");
+  return {lhs.Self(), rhs.Self()};
+}
+
+template <typename L, typename R>
+s21_expr::Binary<L, R, s21_expr::Minus> operator-(
+    const S21MatrixExpr<L> &lhs, const S21MatrixExpr<R> &rhs) {
+  s21_expr::CheckSameSize(lhs, rhs, "operator-: Incorrect matrix size");
+  return {lhs.Self(), rhs.Self()};
+}
+
+// число приводится к типу элементов выражения
+template <typename E>
+s21_expr::Scaled<E> operator*(const S21MatrixExpr<E> &expr,
+                              typename E::value_type number) {
+  return {expr.Self(), number};
+}
+
+template <typename E>
+s21_expr::Scaled<E> operator*(typename E::value_type number,
+                              const S21MatrixExpr<E> &expr) {
+  return {expr.Self(), number};
+}
+
+#endif  // S21_MATRIX_EXPR_H_
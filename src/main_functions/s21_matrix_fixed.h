@@ -0,0 +1,424 @@
+#ifndef S21_MATRIX_FIXED_H_
+#define S21_MATRIX_FIXED_H_
+
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_matrix_oop.h"
+
+// Матрица R x C с размерами, известными при компиляции. Элементы лежат
+// в самом объекте, без кучи; несовпадение размеров - ошибка компиляции.
+// Все циклы имеют постоянные границы, скалярное произведение в умножении
+// раскрыто свёрткой. Определитель и обратная до 4x4 считаются по явным
+// формулам, для больших размеров - методом Гаусса. Операции constexpr.
+template <int R, int C>
+class S21FixedMatrix {
+  static_assert(R > 0 && C > 0, "S21FixedMatrix: dimensions must be positive");
+
+ private:
+  double matrix_[R * C]{};
+  static constexpr double EPSILON = 1e-7;
+
+  static constexpr double Abs(double value) noexcept {
+    return value < 0 ? -value : value;
+  }
+  // std::swap становится constexpr только в C++20
+  static constexpr void Swap(double &lhs, double &rhs) noexcept {
+    const double tmp = lhs;
+    lhs = rhs;
+    rhs = tmp;
+  }
+  // элемент (row, col) произведения this * other
+  template <int K, int... P>
+  constexpr double Dot(const S21FixedMatrix<C, K> &other, int row, int col,
+                       std::integer_sequence<int, P...>) const noexcept {
+    return (0.0 + ... + (matrix_[row * C + P] * other(P, col)));
+  }
+  constexpr S21FixedMatrix<R - 1, C - 1> MinorMatrix(int skip_row,
+                                                     int skip_col) const;
+  // попарные определители 2x2 из строк 0-1 (s) и 2-3 (c) матрицы 4x4
+  constexpr void Minors4(double *s, double *c) const noexcept;
+  constexpr double GaussDeterminant() const;
+  constexpr S21FixedMatrix GaussInverse() const;
+
+ public:
+  constexpr S21FixedMatrix() = default;
+  // элементы по строкам, недостающие - нули
+  constexpr S21FixedMatrix(std::initializer_list<double> values);
+  explicit S21FixedMatrix(const S21Matrix &other);
+  S21Matrix ToMatrix() const;
+
+  static constexpr int GetRows() noexcept { return R; }
+  static constexpr int GetCols() noexcept { return C; }
+  constexpr double *data() noexcept { return matrix_; }
+  constexpr const double *data() const noexcept { return matrix_; }
+  static constexpr int stride() noexcept { return C; }
+  S21MatrixView View() & { return {matrix_, R, C, C}; }
+  S21ConstMatrixView View() const & { return {matrix_, R, C, C}; }
+
+  constexpr bool EqMatrix(const S21FixedMatrix &other) const noexcept;
+  constexpr void SumMatrix(const S21FixedMatrix &other) noexcept;
+  constexpr void SubMatrix(const S21FixedMatrix &other) noexcept;
+  constexpr void MulNumber(const double num) noexcept;
+  constexpr void MulMatrix(const S21FixedMatrix<C, C> &other) noexcept;
+  constexpr S21FixedMatrix<C, R> Transpose() const noexcept;
+  constexpr S21FixedMatrix CalcComplements() const;
+  constexpr double Determinant() const;
+  constexpr S21FixedMatrix InverseMatrix() const;
+
+  template <int K>
+  constexpr S21FixedMatrix<R, K> operator*(
+      const S21FixedMatrix<C, K> &other) const noexcept;
+  constexpr S21FixedMatrix operator+(const S21FixedMatrix &other) const;
+  constexpr S21FixedMatrix operator-(const S21FixedMatrix &other) const;
+  constexpr S21FixedMatrix operator*(double number) const;
+  constexpr bool operator==(const S21FixedMatrix &other) const noexcept;
+  constexpr S21FixedMatrix &operator+=(const S21FixedMatrix &other) noexcept;
+  constexpr S21FixedMatrix &operator-=(const S21FixedMatrix &other) noexcept;
+  constexpr S21FixedMatrix &operator*=(const S21FixedMatrix<C, C> &other);
+  constexpr S21FixedMatrix &operator*=(double number) noexcept;
+  constexpr double &operator()(int row, int col) &;
+  constexpr const double &operator()(int row, int col) const &noexcept {
+    return matrix_[row * C + col];
+  }
+};
+
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> operator*(double number,
+                                         const S21FixedMatrix<R, C> &matrix) {
+  return matrix * number;
+}
+
+template <int R, int C>
+constexpr S21FixedMatrix<R, C>::S21FixedMatrix(
+    std::initializer_list<double> values) {
+  if (values.size() > static_cast<std::size_t>(R * C)) {
+    throw std::length_error("S21FixedMatrix: too many values");
+  }
+  int i = 0;
+  for (double value : values) matrix_[i++] = value;
+}
+
+template <int R, int C>
+S21FixedMatrix<R, C>::S21FixedMatrix(const S21Matrix &other) {
+  if (other.GetRows() != R || other.GetCols() != C) {
+    throw std::logic_error("S21FixedMatrix: incorrect matrix size");
+  }
+  for (int i = 0; i < R; ++i) {
+    for (int j = 0; j < C; ++j) matrix_[i * C + j] = other(i, j);
+  }
+}
+
+template <int R, int C>
+S21Matrix S21FixedMatrix<R, C>::ToMatrix() const {
+  S21Matrix result(R, C);
+  result.View() = View();
+  return result;
+}
+
+template <int R, int C>
+constexpr bool S21FixedMatrix<R, C>::EqMatrix(
+    const S21FixedMatrix &other) const noexcept {
+  bool flag = true;
+  for (int i = 0; i < R * C; ++i) {
+    if (Abs(matrix_[i] - other.matrix_[i]) > EPSILON) flag = false;
+  }
+  return flag;
+}
+
+template <int R, int C>
+constexpr void S21FixedMatrix<R, C>::SumMatrix(
+    const S21FixedMatrix &other) noexcept {
+  for (int i = 0; i < R * C; ++i) matrix_[i] += other.matrix_[i];
+}
+
+template <int R, int C>
+constexpr void S21FixedMatrix<R, C>::SubMatrix(
+    const S21FixedMatrix &other) noexcept {
+  for (int i = 0; i < R * C; ++i) matrix_[i] -= other.matrix_[i];
+}
+
+template <int R, int C>
+constexpr void S21FixedMatrix<R, C>::MulNumber(const double num) noexcept {
+  for (int i = 0; i < R * C; ++i) matrix_[i] *= num;
+}
+
+template <int R, int C>
+constexpr void S21FixedMatrix<R, C>::MulMatrix(
+    const S21FixedMatrix<C, C> &other) noexcept {
+  *this = *this * other;
+}
+
+template <int R, int C>
+template <int K>
+constexpr S21FixedMatrix<R, K> S21FixedMatrix<R, C>::operator*(
+    const S21FixedMatrix<C, K> &other) const noexcept {
+  S21FixedMatrix<R, K> result;
+  for (int i = 0; i < R; ++i) {
+    for (int j = 0; j < K; ++j) {
+      result.data()[i * K + j] =
+          Dot(other, i, j, std::make_integer_sequence<int, C>{});
+    }
+  }
+  return result;
+}
+
+template <int R, int C>
+constexpr S21FixedMatrix<C, R> S21FixedMatrix<R, C>::Transpose()
+    const noexcept {
+  S21FixedMatrix<C, R> result;
+  for (int i = 0; i < R; ++i) {
+    for (int j = 0; j < C; ++j) result.data()[j * R + i] = matrix_[i * C + j];
+  }
+  return result;
+}
+
+template <int R, int C>
+constexpr S21FixedMatrix<R - 1, C - 1> S21FixedMatrix<R, C>::MinorMatrix(
+    int skip_row, int skip_col) const {
+  S21FixedMatrix<R - 1, C - 1> result;
+  for (int i = 0, sub = 0; i < R; ++i) {
+    if (i == skip_row) continue;
+    for (int j = 0; j < C; ++j) {
+      if (j != skip_col) result.data()[sub++] = matrix_[i * C + j];
+    }
+  }
+  return result;
+}
+
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> S21FixedMatrix<R, C>::CalcComplements() const {
+  static_assert(R == C, "CalcComplements: matrix must be square");
+  S21FixedMatrix result;
+  if constexpr (R == 1) {
+    result.matrix_[0] = 1;
+  } else {
+    for (int i = 0; i < R; ++i) {
+      for (int j = 0; j < C; ++j) {
+        const double minor = MinorMatrix(i, j).Determinant();
+        result.matrix_[i * C + j] = (i + j) % 2 == 0 ? minor : -minor;
+      }
+    }
+  }
+  return result;
+}
+
+template <int R, int C>
+constexpr void S21FixedMatrix<R, C>::Minors4(double *s,
+                                             double *c) const noexcept {
+  const double *a = matrix_;
+  s[0] = a[0] * a[5] - a[4] * a[1];
+  s[1] = a[0] * a[6] - a[4] * a[2];
+  s[2] = a[0] * a[7] - a[4] * a[3];
+  s[3] = a[1] * a[6] - a[5] * a[2];
+  s[4] = a[1] * a[7] - a[5] * a[3];
+  s[5] = a[2] * a[7] - a[6] * a[3];
+  c[0] = a[8] * a[13] - a[12] * a[9];
+  c[1] = a[8] * a[14] - a[12] * a[10];
+  c[2] = a[8] * a[15] - a[12] * a[11];
+  c[3] = a[9] * a[14] - a[13] * a[10];
+  c[4] = a[9] * a[15] - a[13] * a[11];
+  c[5] = a[10] * a[15] - a[14] * a[11];
+}
+
+template <int R, int C>
+constexpr double S21FixedMatrix<R, C>::Determinant() const {
+  static_assert(R == C, "Determinant: matrix must be square");
+  const double *a = matrix_;
+  double det = 0;
+  if constexpr (R == 1) {
+    det = a[0];
+  } else if constexpr (R == 2) {
+    det = a[0] * a[3] - a[1] * a[2];
+  } else if constexpr (R == 3) {
+    det = a[0] * (a[4] * a[8] - a[5] * a[7]) -
+          a[1] * (a[3] * a[8] - a[5] * a[6]) +
+          a[2] * (a[3] * a[7] - a[4] * a[6]);
+  } else if constexpr (R == 4) {
+    // разложение Лапласа по строкам 0-1 через дополнительные миноры
+    double s[6]{}, c[6]{};
+    Minors4(s, c);
+    det = s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] -
+          s[4] * c[1] + s[5] * c[0];
+  } else {
+    det = GaussDeterminant();
+  }
+  return det;
+}
+
+template <int R, int C>
+constexpr double S21FixedMatrix<R, C>::GaussDeterminant() const {
+  S21FixedMatrix copy(*this);
+  double *a = copy.matrix_;
+  double det = 1;
+  for (int k = 0; k < R && det != 0; ++k) {
+    int pivot = k;
+    for (int i = k + 1; i < R; ++i) {
+      if (Abs(a[i * C + k]) > Abs(a[pivot * C + k])) pivot = i;
+    }
+    if (pivot != k) {
+      for (int j = 0; j < C; ++j) Swap(a[k * C + j], a[pivot * C + j]);
+      det = -det;
+    }
+    det *= a[k * C + k];
+    for (int i = k + 1; i < R && det != 0; ++i) {
+      const double factor = a[i * C + k] / a[k * C + k];
+      for (int j = k; j < C; ++j) a[i * C + j] -= factor * a[k * C + j];
+    }
+  }
+  return det;
+}
+
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> S21FixedMatrix<R, C>::InverseMatrix() const {
+  static_assert(R == C, "InverseMatrix: matrix must be square");
+  S21FixedMatrix result;
+  if constexpr (R <= 4) {
+    const double det = Determinant();
+    if (Abs(det) < EPSILON) {
+      throw std::logic_error("InverseMatrix: determinant must be non-zero");
+    }
+    const double *a = matrix_;
+    double *b = result.matrix_;
+    if constexpr (R == 1) {
+      b[0] = 1;
+    } else if constexpr (R == 2) {
+      b[0] = a[3];
+      b[1] = -a[1];
+      b[2] = -a[2];
+      b[3] = a[0];
+    } else if constexpr (R == 3) {
+      // присоединённая матрица - транспонированные дополнения
+      result = CalcComplements().Transpose();
+    } else {
+      double s[6]{}, c[6]{};
+      Minors4(s, c);
+      b[0] = a[5] * c[5] - a[6] * c[4] + a[7] * c[3];
+      b[1] = -a[1] * c[5] + a[2] * c[4] - a[3] * c[3];
+      b[2] = a[13] * s[5] - a[14] * s[4] + a[15] * s[3];
+      b[3] = -a[9] * s[5] + a[10] * s[4] - a[11] * s[3];
+      b[4] = -a[4] * c[5] + a[6] * c[2] - a[7] * c[1];
+      b[5] = a[0] * c[5] - a[2] * c[2] + a[3] * c[1];
+      b[6] = -a[12] * s[5] + a[14] * s[2] - a[15] * s[1];
+      b[7] = a[8] * s[5] - a[10] * s[2] + a[11] * s[1];
+      b[8] = a[4] * c[4] - a[5] * c[2] + a[7] * c[0];
+      b[9] = -a[0] * c[4] + a[1] * c[2] - a[3] * c[0];
+      b[10] = a[12] * s[4] - a[13] * s[2] + a[15] * s[0];
+      b[11] = -a[8] * s[4] + a[9] * s[2] - a[11] * s[0];
+      b[12] = -a[4] * c[3] + a[5] * c[1] - a[6] * c[0];
+      b[13] = a[0] * c[3] - a[1] * c[1] + a[2] * c[0];
+      b[14] = -a[12] * s[3] + a[13] * s[1] - a[14] * s[0];
+      b[15] = a[8] * s[3] - a[9] * s[1] + a[10] * s[0];
+    }
+    result.MulNumber(1.0 / det);
+  } else {
+    result = GaussInverse();
+  }
+  return result;
+}
+
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> S21FixedMatrix<R, C>::GaussInverse() const {
+  // Гаусс-Жордан на месте, как в S21Matrix::InverseMatrix
+  S21FixedMatrix result(*this);
+  double *a = result.matrix_;
+  int pivots[R]{};
+  for (int k = 0; k < R; ++k) {
+    int pivot = k;
+    for (int i = k + 1; i < R; ++i) {
+      if (Abs(a[i * C + k]) > Abs(a[pivot * C + k])) pivot = i;
+    }
+    if (Abs(a[pivot * C + k]) < EPSILON) {
+      throw std::logic_error("InverseMatrix: determinant must be non-zero");
+    }
+    pivots[k] = pivot;
+    for (int j = 0; j < C && pivot != k; ++j) {
+      Swap(a[k * C + j], a[pivot * C + j]);
+    }
+    const double inverse = 1.0 / a[k * C + k];
+    a[k * C + k] = 1.0;
+    for (int j = 0; j < C; ++j) a[k * C + j] *= inverse;
+    for (int i = 0; i < R; ++i) {
+      if (i == k) continue;
+      const double factor = a[i * C + k];
+      a[i * C + k] = 0.0;
+      for (int j = 0; j < C; ++j) a[i * C + j] -= factor * a[k * C + j];
+    }
+  }
+  for (int k = R - 1; k >= 0; --k) {
+    for (int i = 0; i < R && pivots[k] != k; ++i) {
+      Swap(a[i * C + k], a[i * C + pivots[k]]);
+    }
+  }
+  return result;
+}
+
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> S21FixedMatrix<R, C>::operator+(
+    const S21FixedMatrix &other) const {
+  S21FixedMatrix result(*this);
+  result.SumMatrix(other);
+  return result;
+}
+
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> S21FixedMatrix<R, C>::operator-(
+    const S21FixedMatrix &other) const {
+  S21FixedMatrix result(*this);
+  result.SubMatrix(other);
+  return result;
+}
+
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> S21FixedMatrix<R, C>::operator*(
+    double number) const {
+  S21FixedMatrix result(*this);
+  result.MulNumber(number);
+  return result;
+}
+
+template <int R, int C>
+constexpr bool S21FixedMatrix<R, C>::operator==(
+    const S21FixedMatrix &other) const noexcept {
+  return EqMatrix(other);
+}
+
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> &S21FixedMatrix<R, C>::operator+=(
+    const S21FixedMatrix &other) noexcept {
+  SumMatrix(other);
+  return *this;
+}
+
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> &S21FixedMatrix<R, C>::operator-=(
+    const S21FixedMatrix &other) noexcept {
+  SubMatrix(other);
+  return *this;
+}
+
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> &S21FixedMatrix<R, C>::operator*=(
+    const S21FixedMatrix<C, C> &other) {
+  MulMatrix(other);
+  return *this;
+}
+
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> &S21FixedMatrix<R, C>::operator*=(
+    double number) noexcept {
+  MulNumber(number);
+  return *this;
+}
+
+template <int R, int C>
+constexpr double &S21FixedMatrix<R, C>::operator()(int row, int col) & {
+  if (row >= R || col >= C || row < 0 || col < 0) {
+    throw std::out_of_range("Index out of range");
+  }
+  return matrix_[row * C + col];
+}
+
+#endif  // S21_MATRIX_FIXED_H_
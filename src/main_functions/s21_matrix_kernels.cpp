@@ -0,0 +1,428 @@
+#include "s21_matrix_kernels.h"
+
+#include <algorithm>  // std::swap_ranges, std::min, std::max, std::fill
+#include <cmath>      // std::abs
+#include <cstddef>    // std::size_t
+#include <vector>     // std::vector
+
+#include "s21_matrix_parallel.h"
+#include "s21_matrix_scheduler.h"
+#include "s21_matrix_simd.h"
+
+namespace {
+// размеры регистрового блока микроядра
+constexpr int kMR = s21_kernels::kGemmMR;
+constexpr int kNR = s21_kernels::kGemmNR;
+// блоки под L1 (панель B kKC x kNR), L2 (блок A kMC x kKC) и L3
+constexpr int kKC = 256;
+constexpr int kMC = 96;
+constexpr int kNC = 2048;
+// меньшие задачи считаются простым циклом i-k-j без упаковки
+constexpr long kSmallGemm = 32 * 32 * 32;
+// сторона плитки блочного LU и размер, с которого оно включается
+constexpr int kLuBlock = 128;
+constexpr int kBlockedLu = 256;
+
+// упаковка блока A (mc x kc) в полосы по kMR строк: для каждого p
+// подряд лежат kMR элементов столбца, недостающие строки - нули
+void PackA(int mc, int kc, const double *a, long a_rs, long a_cs,
+           double alpha, double *packed) {
+  for (int i = 0; i < mc; i += kMR) {
+    const int rows = std::min(kMR, mc - i);
+    for (int p = 0; p < kc; ++p) {
+      for (int r = 0; r < rows; ++r) {
+        packed[r] = alpha * a[(i + r) * a_rs + p * a_cs];
+      }
+      for (int r = rows; r < kMR; ++r) packed[r] = 0.0;
+      packed += kMR;
+    }
+  }
+}
+
+// упаковка панели B (kc x nc) в полосы по kNR столбцов
+void PackB(int kc, int nc, const double *b, long b_rs, long b_cs,
+           double *packed) {
+  for (int j = 0; j < nc; j += kNR) {
+    const int cols = std::min(kNR, nc - j);
+    if (b_rs == 1 && b_cs != 1) {
+      // транспонированный B: столбцы непрерывны, читаем их подряд
+      for (int c = 0; c < kNR; ++c) {
+        const double *src = b + (j + std::min(c, cols - 1)) * b_cs;
+        for (int p = 0; p < kc; ++p) {
+          packed[p * kNR + c] = c < cols ? src[p] : 0.0;
+        }
+      }
+      packed += kc * kNR;
+    } else {
+      for (int p = 0; p < kc; ++p) {
+        const double *src = b + p * b_rs + j * b_cs;
+        for (int c = 0; c < cols; ++c) packed[c] = src[c * b_cs];
+        for (int c = cols; c < kNR; ++c) packed[c] = 0.0;
+        packed += kNR;
+      }
+    }
+  }
+}
+
+void SmallGemm(int m, int n, int k, const double *a, long a_rs, long a_cs,
+               const double *b, long b_rs, long b_cs, double *c, long ldc,
+               double alpha) {
+  for (int i = 0; i < m; ++i) {
+    double *row_c = c + i * ldc;
+    for (int p = 0; p < k; ++p) {
+      const double value = alpha * a[i * a_rs + p * a_cs];
+      const double *row_b = b + p * b_rs;
+      for (int j = 0; j < n; ++j) row_c[j] += value * row_b[j * b_cs];
+    }
+  }
+}
+void BlockedGemm(int m, int n, int k, const double *a, long a_rs,
+                 long a_cs, const double *b, long b_rs, long b_cs, double *c,
+                 long ldc,
+                 double alpha) {
+  const auto micro_kernel = s21_kernels::Simd().gemm_micro;
+  std::vector<double> packed_a(kMC * kKC);
+  std::vector<double> packed_b(
+      static_cast<std::size_t>(kKC) *
+      ((std::min(kNC, n) + kNR - 1) / kNR * kNR));
+  for (int jc = 0; jc < n; jc += kNC) {
+    const int nc = std::min(kNC, n - jc);
+    for (int pc = 0; pc < k; pc += kKC) {
+      const int kc = std::min(kKC, k - pc);
+      PackB(kc, nc, b + pc * b_rs + jc * b_cs, b_rs, b_cs, packed_b.data());
+      for (int ic = 0; ic < m; ic += kMC) {
+        const int mc = std::min(kMC, m - ic);
+        PackA(mc, kc, a + ic * a_rs + pc * a_cs, a_rs, a_cs, alpha,
+              packed_a.data());
+        for (int jr = 0; jr < nc; jr += kNR) {
+          for (int ir = 0; ir < mc; ir += kMR) {
+            micro_kernel(kc, packed_a.data() + static_cast<long>(ir) * kc,
+                         packed_b.data() + static_cast<long>(jr) * kc,
+                         c + (ic + ir) * ldc + jc + jr, ldc,
+                         std::min(kMR, mc - ir), std::min(kNR, nc - jr));
+          }
+        }
+      }
+    }
+  }
+}
+
+int UnblockedLu(double *a, int n, long lda, int *pivots, double tolerance) {
+  int sign = 1;
+  for (int k = 0; k < n && sign != 0; ++k) {
+    int pivot = k;
+    double max = std::abs(a[k * lda + k]);
+    for (int i = k + 1; i < n; ++i) {
+      double value = std::abs(a[i * lda + k]);
+      if (value > max) {
+        max = value;
+        pivot = i;
+      }
+    }
+    pivots[k] = pivot;
+    if (max <= tolerance) {
+      sign = 0;
+    } else {
+      double *row_k = a + k * lda;
+      if (pivot != k) {
+        std::swap_ranges(row_k, row_k + n, a + pivot * lda);
+        sign = -sign;
+      }
+      const double inverse = 1.0 / row_k[k];
+      const long work = static_cast<long>(n - k) * (n - k);
+      s21_kernels::ParallelFor(k + 1, n, work, [=](int from, int to) {
+        for (int i = from; i < to; ++i) {
+          double *row_i = a + i * lda;
+          const double factor = row_i[k] * inverse;
+          row_i[k] = factor;
+          for (int j = k + 1; j < n; ++j) {
+            row_i[j] -= factor * row_k[j];
+          }
+        }
+      });
+    }
+  }
+  return sign;
+}
+
+// LU панели: столбцы [col, col + width), строки [col, n). Строки
+// переставляются только внутри панели, остальные столбцы догоняют
+// перестановки отдельно.
+bool PanelFactorize(double *a, int n, long lda, int col, int width,
+                    int *pivots, double tolerance, int &swaps) {
+  bool regular = true;
+  const int end = col + width;
+  for (int k = col; k < end; ++k) {
+    int pivot = k;
+    double max = std::abs(a[k * lda + k]);
+    for (int i = k + 1; i < n; ++i) {
+      double value = std::abs(a[i * lda + k]);
+      if (value > max) {
+        max = value;
+        pivot = i;
+      }
+    }
+    pivots[k] = pivot;
+    if (max <= tolerance) {
+      regular = false;
+      continue;
+    }
+    double *row_k = a + k * lda;
+    if (pivot != k) {
+      std::swap_ranges(row_k + col, row_k + end, a + pivot * lda + col);
+      ++swaps;
+    }
+    const double inverse = 1.0 / row_k[k];
+    for (int i = k + 1; i < n; ++i) {
+      double *row_i = a + i * lda;
+      const double factor = row_i[k] * inverse;
+      row_i[k] = factor;
+      for (int j = k + 1; j < end; ++j) row_i[j] -= factor * row_k[j];
+    }
+  }
+  return regular;
+}
+
+// перестановки строк [from, to) в столбцах [col, col + width)
+void SwapRows(double *a, long lda, const int *pivots, int from, int to,
+              int col, int width) {
+  for (int r = from; r < to; ++r) {
+    if (pivots[r] != r) {
+      double *row = a + r * lda + col;
+      std::swap_ranges(row, row + width, a + pivots[r] * lda + col);
+    }
+  }
+}
+
+// Блочное LU правого типа графом задач: панель P(k), строка блоков
+// S(k, j) (перестановки и решение с L(k, k)) и обновления плиток
+// T(k, i, j) -= L(i, k) * U(k, j). Панель P(k + 1) зависит только от
+// обновлений своего столбца и стартует, пока досчитываются остальные.
+int TiledLu(double *a, int n, long lda, int *pivots, double tolerance) {
+  const int blocks = (n + kLuBlock - 1) / kLuBlock;
+  auto start = [](int block) { return block * kLuBlock; };
+  auto size = [n](int block) {
+    return std::min(kLuBlock, n - block * kLuBlock);
+  };
+  bool regular = true;
+  int swaps = 0;
+  s21_kernels::TaskGraph graph;
+  // последняя задача, изменившая плитку (i, j)
+  std::vector<int> last(static_cast<std::size_t>(blocks) * blocks, -1);
+  auto column_updates = [&](int from_block, int column) {
+    std::vector<int> dependencies;
+    for (int i = from_block; i < blocks; ++i) {
+      if (last[i * blocks + column] >= 0) {
+        dependencies.push_back(last[i * blocks + column]);
+      }
+    }
+    return dependencies;
+  };
+  for (int k = 0; k < blocks; ++k) {
+    const int kb = start(k);
+    const int kw = size(k);
+    const int panel = graph.Add(
+        [=, &regular, &swaps] {
+          if (!PanelFactorize(a, n, lda, kb, kw, pivots, tolerance, swaps)) {
+            regular = false;
+          }
+        },
+        column_updates(k, k));
+    for (int j = k + 1; j < blocks; ++j) {
+      const int jb = start(j);
+      const int jw = size(j);
+      std::vector<int> dependencies = column_updates(k, j);
+      dependencies.push_back(panel);
+      const int row = graph.Add(
+          [=] {
+            SwapRows(a, lda, pivots, kb, kb + kw, jb, jw);
+            s21_kernels::SolveLower(a + kb * lda + kb, kw, lda, true,
+                                    a + kb * lda + jb, lda, jw);
+          },
+          dependencies);
+      for (int i = k + 1; i < blocks; ++i) {
+        const int ib = start(i);
+        const int iw = size(i);
+        last[i * blocks + j] = graph.Add(
+            [=] {
+              s21_kernels::Gemm(iw, jw, kw, a + ib * lda + kb, lda, 1,
+                                a + kb * lda + jb, lda, 1, a + ib * lda + jb,
+                                lda, -1.0);
+            },
+            {row});
+      }
+    }
+  }
+  graph.Run();
+  // столбцы левее панели никто больше не читает, поэтому их
+  // перестановки выполняются в конце
+  for (int k = 1; k < blocks; ++k) {
+    SwapRows(a, lda, pivots, start(k), start(k) + size(k), 0, start(k));
+  }
+  int sign = 0;
+  if (regular) sign = swaps % 2 == 0 ? 1 : -1;
+  return sign;
+}
+
+// z = x + sign * y для блоков rows x cols; z может совпадать с x или y
+void Combine(int rows, int cols, const double *x, long ldx, double sign,
+             const double *y, long ldy, double *z, long ldz) {
+  const long work = static_cast<long>(rows) * cols;
+  s21_kernels::ParallelFor(0, rows, work, [=](int from, int to) {
+    for (int i = from; i < to; ++i) {
+      const double *row_x = x + i * ldx;
+      const double *row_y = y + i * ldy;
+      double *row_z = z + i * ldz;
+      for (int j = 0; j < cols; ++j) row_z[j] = row_x[j] + sign * row_y[j];
+    }
+  });
+}
+
+void Zero(int rows, int cols, double *c, long ldc) {
+  for (int i = 0; i < rows; ++i) {
+    std::fill(c + i * ldc, c + i * ldc + cols, 0.0);
+  }
+}
+}  // namespace
+
+namespace s21_kernels {
+
+int LuFactorize(double *a, int n, long lda, int *pivots, double tolerance) {
+  return n >= kBlockedLu ? TiledLu(a, n, lda, pivots, tolerance)
+                         : UnblockedLu(a, n, lda, pivots, tolerance);
+}
+
+void ApplyPivots(const int *pivots, int n, double *b, long ldb, int cols) {
+  for (int k = 0; k < n; ++k) {
+    if (pivots[k] != k) {
+      std::swap_ranges(b + k * ldb, b + k * ldb + cols, b + pivots[k] * ldb);
+    }
+  }
+}
+
+void SolveLower(const double *l, int n, long ldl, bool unit_diagonal,
+                double *b, long ldb, int cols) {
+  for (int i = 0; i < n; ++i) {
+    double *row_i = b + i * ldb;
+    for (int k = 0; k < i; ++k) {
+      const double factor = l[i * ldl + k];
+      const double *row_k = b + k * ldb;
+      for (int j = 0; j < cols; ++j) row_i[j] -= factor * row_k[j];
+    }
+    if (!unit_diagonal) {
+      const double inverse = 1.0 / l[i * ldl + i];
+      for (int j = 0; j < cols; ++j) row_i[j] *= inverse;
+    }
+  }
+}
+
+void SolveUpper(const double *u, int n, long ldu, double *b, long ldb,
+                int cols) {
+  for (int i = n - 1; i >= 0; --i) {
+    double *row_i = b + i * ldb;
+    for (int k = i + 1; k < n; ++k) {
+      const double factor = u[i * ldu + k];
+      const double *row_k = b + k * ldb;
+      for (int j = 0; j < cols; ++j) row_i[j] -= factor * row_k[j];
+    }
+    const double inverse = 1.0 / u[i * ldu + i];
+    for (int j = 0; j < cols; ++j) row_i[j] *= inverse;
+  }
+}
+
+void Gemm(int m, int n, int k, const double *a, long a_rs, long a_cs,
+          const double *b, long b_rs, long b_cs, double *c, long ldc,
+          double alpha) {
+  const long work = static_cast<long>(m) * n * k;
+  if (work <= kSmallGemm) {
+    SmallGemm(m, n, k, a, a_rs, a_cs, b, b_rs, b_cs, c, ldc, alpha);
+  } else if (m >= n) {
+    // потоки получают полосы строк C, кратные высоте микроядра
+    ParallelFor(0, (m + kMR - 1) / kMR, work, [&](int from, int to) {
+      const int row = from * kMR;
+      const int rows = std::min(m, to * kMR) - row;
+      BlockedGemm(rows, n, k, a + row * a_rs, a_rs, a_cs, b, b_rs, b_cs,
+                  c + row * ldc, ldc, alpha);
+    });
+  } else {
+    ParallelFor(0, (n + kNR - 1) / kNR, work, [&](int from, int to) {
+      const int col = from * kNR;
+      const int cols = std::min(n, to * kNR) - col;
+      BlockedGemm(m, cols, k, a, a_rs, a_cs, b + col * b_cs, b_rs, b_cs,
+                  c + col, ldc, alpha);
+    });
+  }
+}
+
+long StrassenWorkspace(int m, int n, int k, int cutoff) {
+  long size = 0;
+  while (std::min({m, n, k}) > cutoff) {
+    m /= 2;
+    n /= 2;
+    k /= 2;
+    size += static_cast<long>(m) * std::max(k, n) + static_cast<long>(k) * n;
+  }
+  return size;
+}
+
+void StrassenGemm(int m, int n, int k, const double *a, long lda,
+                  const double *b, long ldb, double *c, long ldc, int cutoff,
+                  double *workspace) {
+  if (std::min({m, n, k}) <= cutoff) {
+    Zero(m, n, c, ldc);
+    Gemm(m, n, k, a, lda, 1, b, ldb, 1, c, ldc);
+    return;
+  }
+  const int mh = m / 2, nh = n / 2, kh = k / 2;
+  const double *a11 = a, *a12 = a + kh, *a21 = a + mh * lda, *a22 = a21 + kh;
+  const double *b11 = b, *b12 = b + nh, *b21 = b + kh * ldb, *b22 = b21 + nh;
+  double *c11 = c, *c12 = c + nh, *c21 = c + mh * ldc, *c22 = c21 + nh;
+  // X - mh x kh (суммы блоков A) или mh x nh (P1), Y - kh x nh
+  double *x = workspace;
+  double *y = x + static_cast<long>(mh) * std::max(kh, nh);
+  double *rest = y + static_cast<long>(kh) * nh;
+  const auto mul = [&](const double *lhs, long ldl, const double *rhs,
+                       long ldr, double *product, long ldp) {
+    StrassenGemm(mh, nh, kh, lhs, ldl, rhs, ldr, product, ldp, cutoff, rest);
+  };
+  // порядок Буайе-Дюма-Перне-Чжоу: произведения пишутся прямо
+  // в четверти C, поэтому временных блоков только два
+  Combine(mh, kh, a11, lda, -1.0, a21, lda, x, kh);  // S3
+  Combine(kh, nh, b22, ldb, -1.0, b12, ldb, y, nh);  // T3
+  mul(x, kh, y, nh, c21, ldc);                        // P7
+  Combine(mh, kh, a21, lda, 1.0, a22, lda, x, kh);   // S1
+  Combine(kh, nh, b12, ldb, -1.0, b11, ldb, y, nh);  // T1
+  mul(x, kh, y, nh, c22, ldc);                        // P5
+  Combine(mh, kh, x, kh, -1.0, a11, lda, x, kh);     // S2
+  Combine(kh, nh, b22, ldb, -1.0, y, nh, y, nh);     // T2
+  mul(x, kh, y, nh, c12, ldc);                        // P6
+  Combine(mh, kh, a12, lda, -1.0, x, kh, x, kh);     // S4
+  mul(x, kh, b22, ldb, c11, ldc);                     // P3
+  mul(a11, lda, b11, ldb, x, nh);                     // P1
+  Combine(mh, nh, x, nh, 1.0, c12, ldc, c12, ldc);      // U2 = P1 + P6
+  Combine(mh, nh, c12, ldc, 1.0, c21, ldc, c21, ldc);   // U3 = U2 + P7
+  Combine(mh, nh, c12, ldc, 1.0, c22, ldc, c12, ldc);   // U4 = U2 + P5
+  Combine(mh, nh, c21, ldc, 1.0, c22, ldc, c22, ldc);   // C22 = U3 + P5
+  Combine(mh, nh, c12, ldc, 1.0, c11, ldc, c12, ldc);   // C12 = U4 + P3
+  Combine(kh, nh, y, nh, -1.0, b21, ldb, y, nh);        // T4
+  mul(a22, lda, y, nh, c11, ldc);                       // P4
+  Combine(mh, nh, c21, ldc, -1.0, c11, ldc, c21, ldc);  // C21 = U3 - P4
+  mul(a12, lda, b21, ldb, c11, ldc);                    // P2
+  Combine(mh, nh, c11, ldc, 1.0, x, nh, c11, ldc);      // C11 = P1 + P2
+  // нечётные размеры: последние строка, столбец и слагаемое по k
+  // досчитываются обычным ядром
+  const int m2 = 2 * mh, n2 = 2 * nh, k2 = 2 * kh;
+  if (k2 < k) {
+    Gemm(m2, n2, 1, a + k2, lda, 1, b + k2 * ldb, ldb, 1, c, ldc);
+  }
+  if (n2 < n) {
+    Zero(m2, 1, c + n2, ldc);
+    Gemm(m2, 1, k, a, lda, 1, b + n2, ldb, 1, c + n2, ldc);
+  }
+  if (m2 < m) {
+    Zero(1, n, c + m2 * ldc, ldc);
+    Gemm(1, n, k, a + m2 * lda, lda, 1, b, ldb, 1, c + m2 * ldc, ldc);
+  }
+}
+
+}  // namespace s21_kernels
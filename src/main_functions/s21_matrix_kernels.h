@@ -0,0 +1,45 @@
+#ifndef S21_MATRIX_KERNELS_H_
+#define S21_MATRIX_KERNELS_H_
+
+// Низкоуровневые вычислительные ядра над непрерывными буферами
+// с построчным хранением (lda - шаг между строками в элементах, long:
+// смещения в больших матрицах не помещаются в int).
+namespace s21_kernels {
+
+// LU-разложение с частичным выбором ведущего элемента на месте:
+// под диагональю остаются множители L, на диагонали и выше - U.
+// Возвращает знак перестановки строк или 0, если ведущий элемент
+// по модулю не превысил tolerance (матрица вырождена). Большие матрицы
+// раскладываются блочно графом задач планировщика.
+int LuFactorize(double *a, int n, long lda, int *pivots, double tolerance);
+
+// B := P * B для перестановки, полученной из LuFactorize
+void ApplyPivots(const int *pivots, int n, double *b, long ldb, int cols);
+
+// решение L * X = B (unit_diagonal) или U * X = B на месте в B
+void SolveLower(const double *l, int n, long ldl, bool unit_diagonal,
+                double *b, long ldb, int cols);
+void SolveUpper(const double *u, int n, long ldu, double *b, long ldb,
+                int cols);
+
+// C(m x n) += alpha * A(m x k) * B(k x n). Элемент A(i, p) лежит по
+// адресу a[i * a_rs + p * a_cs], аналогично для B, поэтому
+// транспонированный операнд передаётся перестановкой шагов без копирования.
+// Шаги - long: смещения в больших матрицах не помещаются в int.
+void Gemm(int m, int n, int k, const double *a, long a_rs, long a_cs,
+          const double *b, long b_rs, long b_cs, double *c, long ldc,
+          double alpha = 1.0);
+
+// C(m x n) = A(m x k) * B(k x n) методом Штрассена-Винограда: 7 умножений
+// половинных блоков вместо 8, пока наименьший размер больше cutoff,
+// дальше - Gemm. Нечётные размеры обрабатываются отщеплением последней
+// строки или столбца. Временные блоки всех уровней берутся из workspace
+// длины не меньше StrassenWorkspace(m, n, k, cutoff).
+long StrassenWorkspace(int m, int n, int k, int cutoff);
+void StrassenGemm(int m, int n, int k, const double *a, long lda,
+                  const double *b, long ldb, double *c, long ldc, int cutoff,
+                  double *workspace);
+
+}  // namespace s21_kernels
+
+#endif  // S21_MATRIX_KERNELS_H_
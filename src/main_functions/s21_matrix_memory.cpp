@@ -0,0 +1,148 @@
+#include "s21_matrix_memory.h"
+
+#include <algorithm>  // std::max
+#include <memory>     // std::align
+
+namespace {
+// блоки пула и куски арены выровнены не хуже буферов матриц
+constexpr std::size_t kChunkAlignment = 64;
+// столько байт пул запрашивает сверху за раз для мелких классов
+constexpr std::size_t kPoolChunkBytes = std::size_t(1) << 16;
+
+thread_local std::pmr::memory_resource *current_resource = nullptr;
+
+std::size_t BlocksPerChunk(int shift) {
+  return std::max<std::size_t>(1, kPoolChunkBytes >> shift);
+}
+}  // namespace
+
+void S21SetMemoryResource(std::pmr::memory_resource *resource) noexcept {
+  current_resource = resource;
+}
+
+std::pmr::memory_resource *S21GetMemoryResource() noexcept {
+  return current_resource ? current_resource
+                          : std::pmr::get_default_resource();
+}
+
+S21PoolResource::S21PoolResource(std::pmr::memory_resource *upstream)
+    : upstream_(upstream) {}
+
+S21PoolResource::~S21PoolResource() { Release(); }
+
+void S21PoolResource::Release() noexcept {
+  for (int shift = kMinShift; shift <= kMaxShift; ++shift) {
+    SizeClass &size_class = classes_[shift - kMinShift];
+    std::lock_guard<std::mutex> lock(size_class.mutex);
+    for (void *chunk : size_class.chunks) {
+      upstream_->deallocate(chunk, BlocksPerChunk(shift) << shift,
+                            kChunkAlignment);
+    }
+    size_class.chunks.clear();
+    size_class.free = nullptr;
+  }
+}
+
+int S21PoolResource::ClassShift(std::size_t bytes,
+                                std::size_t alignment) noexcept {
+  const std::size_t size =
+      std::max({bytes, alignment, std::size_t(1) << kMinShift});
+  int shift = kMinShift;
+  while (shift <= kMaxShift && (std::size_t(1) << shift) < size) ++shift;
+  // слишком большие блоки и особое выравнивание - напрямую сверху
+  return shift > kMaxShift || alignment > kChunkAlignment ? -1 : shift;
+}
+
+void *S21PoolResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+  const int shift = ClassShift(bytes, alignment);
+  if (shift < 0) return upstream_->allocate(bytes, alignment);
+  SizeClass &size_class = classes_[shift - kMinShift];
+  std::lock_guard<std::mutex> lock(size_class.mutex);
+  if (!size_class.free) {
+    const std::size_t count = BlocksPerChunk(shift);
+    size_class.chunks.reserve(size_class.chunks.size() + 1);
+    char *chunk = static_cast<char *>(
+        upstream_->allocate(count << shift, kChunkAlignment));
+    size_class.chunks.push_back(chunk);
+    for (std::size_t i = count; i-- > 0;) {
+      auto *block = reinterpret_cast<FreeBlock *>(chunk + (i << shift));
+      block->next = size_class.free;
+      size_class.free = block;
+    }
+  }
+  FreeBlock *block = size_class.free;
+  size_class.free = block->next;
+  return block;
+}
+
+void S21PoolResource::do_deallocate(void *pointer, std::size_t bytes,
+                                    std::size_t alignment) {
+  const int shift = ClassShift(bytes, alignment);
+  if (shift < 0) {
+    upstream_->deallocate(pointer, bytes, alignment);
+  } else {
+    SizeClass &size_class = classes_[shift - kMinShift];
+    std::lock_guard<std::mutex> lock(size_class.mutex);
+    auto *block = static_cast<FreeBlock *>(pointer);
+    block->next = size_class.free;
+    size_class.free = block;
+  }
+}
+
+bool S21PoolResource::do_is_equal(
+    const std::pmr::memory_resource &other) const noexcept {
+  return this == &other;
+}
+
+S21ArenaResource::S21ArenaResource(std::size_t chunk_bytes,
+                                   std::pmr::memory_resource *upstream)
+    : upstream_(upstream), chunk_bytes_(chunk_bytes) {}
+
+S21ArenaResource::~S21ArenaResource() { Release(); }
+
+void S21ArenaResource::Reset() noexcept {
+  current_ = 0;
+  offset_ = 0;
+}
+
+void S21ArenaResource::Release() noexcept {
+  for (const Chunk &chunk : chunks_) {
+    upstream_->deallocate(chunk.data, chunk.size, chunk.alignment);
+  }
+  chunks_.clear();
+  Reset();
+}
+
+void *S21ArenaResource::do_allocate(std::size_t bytes,
+                                    std::size_t alignment) {
+  // после Reset() сначала заново заполняются уже полученные куски
+  for (; current_ < chunks_.size(); ++current_, offset_ = 0) {
+    const Chunk &chunk = chunks_[current_];
+    void *pointer = static_cast<char *>(chunk.data) + offset_;
+    std::size_t space = chunk.size - offset_;
+    if (std::align(alignment, bytes, pointer, space)) {
+      offset_ = chunk.size - space + bytes;
+      return pointer;
+    }
+  }
+  const std::size_t size = std::max(chunk_bytes_, bytes);
+  const std::size_t chunk_alignment = std::max(alignment, kChunkAlignment);
+  chunks_.reserve(chunks_.size() + 1);
+  chunks_.push_back(
+      {upstream_->allocate(size, chunk_alignment), size, chunk_alignment});
+  current_ = chunks_.size() - 1;
+  offset_ = bytes;
+  return chunks_.back().data;
+}
+
+void S21ArenaResource::do_deallocate(void *, std::size_t, std::size_t) {}
+
+bool S21ArenaResource::do_is_equal(
+    const std::pmr::memory_resource &other) const noexcept {
+  return this == &other;
+}
+
+S21ArenaResource &S21ThreadArena() {
+  thread_local S21ArenaResource arena;
+  return arena;
+}
@@ -0,0 +1,95 @@
+#ifndef S21_MATRIX_MEMORY_H_
+#define S21_MATRIX_MEMORY_H_
+
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+// Ресурс, из которого выделяются буферы новых матриц текущего потока.
+// nullptr возвращает std::pmr::get_default_resource(). Матрица запоминает
+// свой ресурс и возвращает буфер именно ему.
+void S21SetMemoryResource(std::pmr::memory_resource *resource) noexcept;
+std::pmr::memory_resource *S21GetMemoryResource() noexcept;
+
+// Пул с классами размеров (степени двойки): освобождённый блок
+// кладётся в список своего класса и отдаётся следующей матрице того же
+// размера. У каждого класса свой мьютекс, поэтому потоки, работающие
+// с разными размерами, не конкурируют. Память возвращается вышестоящему
+// ресурсу только в Release() и деструкторе.
+class S21PoolResource : public std::pmr::memory_resource {
+ public:
+  explicit S21PoolResource(
+      std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+  S21PoolResource(const S21PoolResource &) = delete;
+  S21PoolResource &operator=(const S21PoolResource &) = delete;
+  ~S21PoolResource() override;
+
+  // все выданные блоки становятся недействительными
+  void Release() noexcept;
+
+ private:
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+  struct SizeClass {
+    std::mutex mutex;
+    FreeBlock *free = nullptr;
+    std::vector<void *> chunks;
+  };
+  static constexpr int kMinShift = 6;
+  static constexpr int kMaxShift = 22;
+
+  // log2 размера блока или -1, если запрос идёт напрямую к upstream_
+  static int ClassShift(std::size_t bytes, std::size_t alignment) noexcept;
+
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void *pointer, std::size_t bytes,
+                     std::size_t alignment) override;
+  bool do_is_equal(
+      const std::pmr::memory_resource &other) const noexcept override;
+
+  std::pmr::memory_resource *upstream_;
+  SizeClass classes_[kMaxShift - kMinShift + 1];
+};
+
+// Арена: выделение - сдвиг указателя, освобождение ничего не делает.
+// Reset() разом освобождает всё выделенное, сохраняя куски для следующей
+// партии. Не потокобезопасна - каждому потоку своя арена (S21ThreadArena).
+class S21ArenaResource : public std::pmr::memory_resource {
+ public:
+  explicit S21ArenaResource(
+      std::size_t chunk_bytes = std::size_t(1) << 20,
+      std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+  S21ArenaResource(const S21ArenaResource &) = delete;
+  S21ArenaResource &operator=(const S21ArenaResource &) = delete;
+  ~S21ArenaResource() override;
+
+  // матрицы, выделенные до Reset(), использовать больше нельзя
+  void Reset() noexcept;
+  void Release() noexcept;
+
+ private:
+  struct Chunk {
+    void *data;
+    std::size_t size;
+    std::size_t alignment;
+  };
+
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void *pointer, std::size_t bytes,
+                     std::size_t alignment) override;
+  bool do_is_equal(
+      const std::pmr::memory_resource &other) const noexcept override;
+
+  std::pmr::memory_resource *upstream_;
+  std::size_t chunk_bytes_;
+  std::vector<Chunk> chunks_;
+  std::size_t current_ = 0;
+  std::size_t offset_ = 0;
+};
+
+// арена вызывающего потока
+S21ArenaResource &S21ThreadArena();
+
+#endif  // S21_MATRIX_MEMORY_H_
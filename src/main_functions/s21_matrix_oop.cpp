@@ -1,55 +1,362 @@
 #include "s21_matrix_oop.h"
 
-#include <algorithm>  // std::min
-#include <cmath>      // std::abs
-#include <stdexcept>  // error lib
-#include <stdexcept>  // logic_error
-#include <utility>    // std::move
+#include <algorithm>    // std::min, std::copy, std::uninitialized_fill
+#include <atomic>       // std::atomic
+#include <climits>      // INT_MAX
+#include <cmath>        // std::abs
+#include <complex>      // std::complex
+#include <cstddef>      // std::size_t
+#include <stdexcept>    // error lib
+#include <stdexcept>    // logic_error
+#include <type_traits>  // std::is_same
+#include <utility>      // std::move
+#include <vector>       // std::vector
+
+#include "s21_matrix_decomposition.h"
+#include "s21_matrix_parallel.h"
+#include "s21_matrix_simd.h"
+
+namespace {
+// выравнивание буфера по кэш-линии
+constexpr std::size_t kAlignment = 64;
+
+// строки длиной от кэш-линии дополняются до кратной ей длины,
+// чтобы каждая строка начиналась с выровненного адреса
+template <typename T>
+int PaddedStride(int cols) {
+  constexpr int kLineElements = kAlignment / sizeof(T);
+  int stride = cols;
+  if (cols >= kLineElements) {
+    stride = (cols + kLineElements - 1) / kLineElements * kLineElements;
+  }
+  return stride;
+}
 
-S21Matrix::S21Matrix() : rows_(0), cols_(0) {
-  matrix_ = new double *[rows_] {};
+template <typename T>
+T *Allocate(std::pmr::memory_resource *resource, int rows, int stride) {
+  T *buffer = nullptr;
+  std::size_t count = static_cast<std::size_t>(rows) * stride;
+  if (count > 0) {
+    buffer =
+        static_cast<T *>(resource->allocate(count * sizeof(T), kAlignment));
+    std::uninitialized_fill(buffer, buffer + count, T());
+  }
+  return buffer;
 }
 
-S21Matrix::S21Matrix(int rows, int cols) : rows_(rows), cols_(cols) {
-  matrix_ = new double *[rows_] {};
-  for (int i = 0; i < rows_; ++i) {
-    matrix_[i] = new double[cols_]{};
+template <typename T>
+void Deallocate(std::pmr::memory_resource *resource, T *buffer, int rows,
+                int stride) noexcept {
+  if (buffer) {
+    resource->deallocate(
+        buffer, static_cast<std::size_t>(rows) * stride * sizeof(T),
+        kAlignment);
+  }
+}
+
+// копирует rows строк по cols элементов; плотные строки без промежутков -
+// одним блоком, иначе построчно, не трогая хвосты строк приёмника
+template <typename T>
+void CopyRows(const T *src, int src_stride, T *dst, int dst_stride, int rows,
+              int cols) {
+  if (rows > 0 && cols > 0) {
+    if (src_stride == cols && dst_stride == cols) {
+      std::copy(src, src + static_cast<long>(rows) * cols, dst);
+    } else {
+      for (int i = 0; i < rows; ++i) {
+        const T *row = src + static_cast<long>(i) * src_stride;
+        std::copy(row, row + cols, dst + static_cast<long>(i) * dst_stride);
+      }
+    }
+  }
+}
+
+// плотный массив rows x cols по строкам становится cols x rows на месте:
+// элементы переставляются по циклам перестановки, пройденные отмечаются
+// в битовой карте (бит на элемент)
+template <typename T>
+void TransposeCycles(T *data, int rows, int cols) {
+  const long size = static_cast<long>(rows) * cols;
+  std::vector<bool> moved(size);
+  for (long start = 1; start + 1 < size; ++start) {
+    if (moved[start]) continue;
+    T value = data[start];
+    long i = start;
+    do {
+      i = i % cols * rows + i / cols;
+      std::swap(value, data[i]);
+      moved[i] = true;
+    } while (i != start);
+  }
+}
+
+// векторные ядра есть для double и float, остальные типы - простым циклом
+template <typename T>
+void AddRow(T *dst, const T *src, int n) {
+  if constexpr (std::is_same<T, double>::value) {
+    s21_kernels::Simd().add(dst, src, n);
+  } else if constexpr (std::is_same<T, float>::value) {
+    s21_kernels::Simd().add_float(dst, src, n);
+  } else {
+    for (int i = 0; i < n; ++i) dst[i] += src[i];
+  }
+}
+
+template <typename T>
+void SubRow(T *dst, const T *src, int n) {
+  if constexpr (std::is_same<T, double>::value) {
+    s21_kernels::Simd().sub(dst, src, n);
+  } else if constexpr (std::is_same<T, float>::value) {
+    s21_kernels::Simd().sub_float(dst, src, n);
+  } else {
+    for (int i = 0; i < n; ++i) dst[i] -= src[i];
+  }
+}
+
+template <typename T>
+void ScaleRow(T *dst, T value, int n) {
+  if constexpr (std::is_same<T, double>::value) {
+    s21_kernels::Simd().scale(dst, value, n);
+  } else if constexpr (std::is_same<T, float>::value) {
+    s21_kernels::Simd().scale_float(dst, value, n);
+  } else {
+    for (int i = 0; i < n; ++i) dst[i] *= value;
   }
 }
 
-S21Matrix::S21Matrix(const S21Matrix &other)
-    : rows_(other.rows_), cols_(other.cols_) {
-  matrix_ = new double *[rows_];
-  for (int i = 0; i < rows_; i++) {
-    matrix_[i] = new double[cols_];
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] = other.matrix_[i][j];
+// dst(j, i) = src(i, j) для блока rows x cols; для double - перестановкой
+// плиток в регистрах
+template <typename T>
+void TransposeBlock(const T *src, int lds, T *dst, int ldd, int rows,
+                    int cols) {
+  if constexpr (std::is_same<T, double>::value) {
+    s21_kernels::Simd().transpose(src, lds, dst, ldd, rows, cols);
+  } else {
+    for (int i = 0; i < rows; ++i) {
+      const T *row = src + static_cast<long>(i) * lds;
+      for (int j = 0; j < cols; ++j) {
+        dst[static_cast<long>(j) * ldd + i] = row[j];
+      }
     }
   }
 }
 
-S21Matrix::S21Matrix(S21Matrix &&other) noexcept
-    : rows_(other.rows_), cols_(other.cols_), matrix_(other.matrix_) {
+template <typename T, typename Real>
+bool EqualRow(const T *a, const T *b, int n, Real epsilon) {
+  bool flag = true;
+  if constexpr (std::is_same<T, double>::value) {
+    flag = s21_kernels::Simd().equal(a, b, n, epsilon);
+  } else {
+    for (int i = 0; i < n && flag; ++i) {
+      if (std::abs(a[i] - b[i]) > epsilon) flag = false;
+    }
+  }
+  return flag;
+}
+
+// C += A * B построчно (i-k-j) для типов без ядра GEMM
+template <typename T>
+void LoopMulAdd(S21BasicMatrixView<const T> a, S21BasicMatrixView<const T> b,
+                S21BasicMatrixView<T> c) {
+  const int n = b.GetCols(), k = a.GetCols();
+  const long work = static_cast<long>(a.GetRows()) * n * k;
+  s21_kernels::ParallelFor(0, a.GetRows(), work, [&](int from, int to) {
+    for (int i = from; i < to; ++i) {
+      for (int p = 0; p < k; ++p) {
+        const T value = a(i, p);
+        for (int j = 0; j < n; ++j) c(i, j) += value * b(p, j);
+      }
+    }
+  });
+}
+
+// определитель исключением Гаусса с выбором ведущего элемента
+// для типов, которые не поддерживает S21LU
+template <typename T>
+T GaussDeterminant(S21BasicMatrix<T> a) {
+  const int n = a.GetRows();
+  T det = T(1);
+  for (int k = 0; k < n && det != T(0); ++k) {
+    int pivot = k;
+    for (int i = k + 1; i < n; ++i) {
+      if (std::abs(a(i, k)) > std::abs(a(pivot, k))) pivot = i;
+    }
+    T *row_k = a.data() + static_cast<long>(k) * a.stride();
+    if (pivot != k) {
+      T *row_pivot = a.data() + static_cast<long>(pivot) * a.stride();
+      std::swap_ranges(row_k, row_k + n, row_pivot);
+      det = -det;
+    }
+    det *= row_k[k];
+    for (int i = k + 1; i < n && det != T(0); ++i) {
+      T *row_i = a.data() + static_cast<long>(i) * a.stride();
+      const T factor = row_i[k] / row_k[k];
+      for (int j = k; j < n; ++j) row_i[j] -= factor * row_k[j];
+    }
+  }
+  return det;
+}
+
+// до этого размера разложение по строке дешевле LU (см. bench/)
+constexpr int kCofactorLimit = 3;
+
+// сторона квадратного блока при транспонировании
+constexpr int kTransposeBlock = 32;
+
+// ёмкость под needed элементов: текущая, если хватает, иначе с запасом
+int GrowCapacity(int current, int needed) {
+  int capacity = current;
+  if (needed > current) {
+    capacity = std::max(needed, current < INT_MAX / 2 ? 2 * current : INT_MAX);
+  }
+  return capacity;
+}
+}  // namespace
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix()
+    : rows_(0),
+      cols_(0),
+      stride_(0),
+      capacity_(0),
+      matrix_(nullptr),
+      resource_(S21GetMemoryResource()) {}
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols)
+    : S21BasicMatrix(rows, cols, S21GetMemoryResource()) {}
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols,
+                                  std::pmr::memory_resource *resource)
+    : rows_(rows),
+      cols_(cols),
+      stride_(0),
+      capacity_(rows),
+      matrix_(nullptr),
+      resource_(resource) {
+  if (rows < 0 || cols < 0) {
+    throw std::length_error("S21Matrix: negative matrix size");
+  }
+  stride_ = PaddedStride<T>(cols_);
+  matrix_ = Allocate<T>(resource_, rows_, stride_);
+}
+
+// копия, как и в std::pmr, берёт ресурс текущего потока
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix &other)
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      stride_(PaddedStride<T>(other.cols_)),
+      capacity_(other.rows_),
+      matrix_(nullptr),
+      resource_(S21GetMemoryResource()) {
+  matrix_ = Allocate<T>(resource_, rows_, stride_);
+  CopyRows(other.matrix_, other.stride_, matrix_, stride_, rows_, cols_);
+}
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(S21BasicMatrix &&other) noexcept
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      stride_(other.stride_),
+      capacity_(other.capacity_),
+      matrix_(other.matrix_),
+      resource_(other.resource_),
+      deleter_(std::move(other.deleter_)) {
   other.cols_ = 0;
   other.rows_ = 0;
+  other.stride_ = 0;
+  other.capacity_ = 0;
   other.matrix_ = nullptr;
+  other.deleter_ = nullptr;
 }
 
-S21Matrix::~S21Matrix() { Free(); }
+template <typename T>
+S21BasicMatrix<T>::~S21BasicMatrix() { Free(); }
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Adopt(T *data, int rows, int cols,
+                                           Deleter deleter, S21Layout layout,
+                                           int stride) {
+  S21BasicMatrix result = Borrow(data, rows, cols, S21Layout::kRowMajor,
+                                 layout == S21Layout::kRowMajor ? stride : 0);
+  if (layout == S21Layout::kColMajor) {
+    if (stride != 0 && stride != rows) {
+      throw std::logic_error("Adopt: column-major buffer must be dense");
+    }
+    // буфер по столбцам - это плотная матрица cols x rows по строкам
+    TransposeCycles(data, cols, rows);
+  }
+  result.deleter_ = std::move(deleter);
+  return result;
+}
 
-void S21Matrix::Free() noexcept {
-  for (int i = 0; i < rows_; i++) {
-    delete[] matrix_[i];
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Borrow(T *data, int rows, int cols,
+                                            S21Layout layout, int stride) {
+  if (rows < 0 || cols < 0) {
+    throw std::length_error("S21Matrix: negative matrix size");
+  }
+  if (layout == S21Layout::kColMajor) {
+    throw std::logic_error(
+        "Borrow: column-major buffer can not be borrowed, use a view");
+  }
+  if (stride == 0) stride = cols;
+  if (stride < cols || (!data && rows > 0 && cols > 0)) {
+    throw std::logic_error("Borrow: incorrect buffer");
+  }
+  S21BasicMatrix result;
+  result.rows_ = rows;
+  result.cols_ = cols;
+  result.stride_ = stride;
+  result.capacity_ = rows;
+  result.matrix_ = data;
+  // чужой буфер не освобождается
+  result.deleter_ = [](T *) {};
+  return result;
+}
+
+template <typename T>
+typename S21BasicMatrix<T>::Buffer S21BasicMatrix<T>::release() {
+  Deleter deleter = std::move(deleter_);
+  if (!deleter) deleter = ResourceDeleter();
+  Buffer buffer(matrix_, std::move(deleter));
+  deleter_ = nullptr;
+  matrix_ = nullptr;
+  Free();
+  return buffer;
+}
+
+template <typename T>
+typename S21BasicMatrix<T>::Deleter S21BasicMatrix<T>::ResourceDeleter()
+    const {
+  const std::size_t bytes =
+      static_cast<std::size_t>(capacity_) * stride_ * sizeof(T);
+  return [resource = resource_, bytes](T *buffer) {
+    resource->deallocate(buffer, bytes, kAlignment);
+  };
+}
+
+template <typename T>
+void S21BasicMatrix<T>::Free() noexcept {
+  if (deleter_) {
+    if (matrix_) deleter_(matrix_);
+    deleter_ = nullptr;
+  } else {
+    Deallocate(resource_, matrix_, capacity_, stride_);
   }
-  delete[] matrix_;
   rows_ = 0;
   cols_ = 0;
+  stride_ = 0;
+  capacity_ = 0;
   matrix_ = nullptr;
 }
 
-S21Matrix S21Matrix::MinorMatrix(const int skip_row,
-                                 const int skip_column) const {
-  S21Matrix result(rows_ - 1, cols_ - 1);
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::MinorMatrix(
+    const int skip_row, const int skip_column) const {
+  S21BasicMatrix result(rows_ - 1, cols_ - 1);
   for (int row = 0, sub_row = 0; row < rows_; row++) {
     if (row == skip_row) continue;
     for (int col = 0, sub_col = 0; col < cols_; col++) {
@@ -62,77 +369,149 @@ S21Matrix S21Matrix::MinorMatrix(const int skip_row,
   return result;
 }
 
-bool S21Matrix::EqMatrix(const S21Matrix &other) const {
+template <typename T>
+bool S21BasicMatrix<T>::EqMatrix(const S21BasicMatrix &other) const {
   bool flag = true;
   if (rows_ != other.rows_ || cols_ != other.cols_)
     flag = false;
   else {
-    for (int i = 0; i < rows_; i++) {
-      for (int j = 0; j < cols_; j++) {
-        if (std::abs((*this)(i, j) - other(i, j)) > EPSILON) flag = false;
+    std::atomic<bool> same{true};
+    s21_kernels::ParallelFor(0, rows_, Size(), [&](int from, int to) {
+      for (int i = from; i < to && same.load(std::memory_order_relaxed); i++) {
+        const long offset = static_cast<long>(i) * stride_;
+        const long other_offset = static_cast<long>(i) * other.stride_;
+        if (!EqualRow(matrix_ + offset, other.matrix_ + other_offset, cols_,
+                      EPSILON)) {
+          same.store(false, std::memory_order_relaxed);
+        }
       }
-    }
+    });
+    flag = same.load();
   }
   return flag;
 }
 
-void S21Matrix::SumMatrix(const S21Matrix &other) {
+template <typename T>
+void S21BasicMatrix<T>::SumMatrix(const S21BasicMatrix &other) {
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     throw std::logic_error("SumMatrix: Incorrect matrix size");
   }
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      (*this)(i, j) += other(i, j);
+  s21_kernels::ParallelFor(0, rows_, Size(), [&](int from, int to) {
+    for (int i = from; i < to; i++) {
+      AddRow(matrix_ + static_cast<long>(i) * stride_,
+             other.matrix_ + static_cast<long>(i) * other.stride_, cols_);
     }
-  }
+  });
 }
 
-void S21Matrix::SubMatrix(const S21Matrix &other) {
+template <typename T>
+void S21BasicMatrix<T>::SubMatrix(const S21BasicMatrix &other) {
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     throw std::logic_error("SubMatrix: Incorrect matrix size");
   }
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      (*this)(i, j) -= other(i, j);
+  s21_kernels::ParallelFor(0, rows_, Size(), [&](int from, int to) {
+    for (int i = from; i < to; i++) {
+      SubRow(matrix_ + static_cast<long>(i) * stride_,
+             other.matrix_ + static_cast<long>(i) * other.stride_, cols_);
     }
-  }
+  });
 }
 
-void S21Matrix::MulNumber(const double num) {
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      (*this)(i, j) *= num;
+template <typename T>
+void S21BasicMatrix<T>::MulNumber(const T num) {
+  s21_kernels::ParallelFor(0, rows_, Size(), [&](int from, int to) {
+    for (int i = from; i < to; i++) {
+      ScaleRow(matrix_ + static_cast<long>(i) * stride_, num, cols_);
     }
-  }
+  });
 }
 
-void S21Matrix::MulMatrix(const S21Matrix &other) {
-  if (cols_ != other.rows_) {
-    throw std::logic_error("MulMatrix: incorrect matrix size");
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Product(
+    const S21BasicMatrix &other) const {
+  return S21MulMatrix(View(), other.View());
+}
+
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrix &other) {
+  *this = Product(other);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::MulTransposedMatrix(const S21BasicMatrix &other) {
+  if (cols_ != other.cols_) {
+    throw std::logic_error("MulTransposedMatrix: incorrect matrix size");
   }
-  S21Matrix result(rows_, other.cols_);
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < other.cols_; j++) {
-      for (int k = 0; k < cols_; k++) {
-        result(i, j) += (*this)(i, k) * other(k, j);
+  // other^T читается через переставленные шаги, без копии
+  *this = S21MulMatrix(View(), other.View().Transposed());
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Transpose() const {
+  S21BasicMatrix result(cols_, rows_);
+  // блоками kTransposeBlock x kTransposeBlock, чтобы и чтение, и запись
+  // оставались в пределах нескольких кэш-линий; потоки делят полосы строк
+  const int blocks = (rows_ + kTransposeBlock - 1) / kTransposeBlock;
+  s21_kernels::ParallelFor(0, blocks, Size(), [&](int from, int to) {
+    for (int ib = from * kTransposeBlock;
+         ib < std::min(rows_, to * kTransposeBlock); ib += kTransposeBlock) {
+      const int height = std::min(rows_ - ib, kTransposeBlock);
+      for (int jb = 0; jb < cols_; jb += kTransposeBlock) {
+        const T *src = matrix_ + static_cast<long>(ib) * stride_ + jb;
+        T *dst = result.matrix_ + static_cast<long>(jb) * result.stride_ + ib;
+        TransposeBlock(src, stride_, dst, result.stride_, height,
+                       std::min(cols_ - jb, kTransposeBlock));
       }
     }
-  }
-  *this = std::move(result);
+  });
+  return result;
 }
 
-S21Matrix S21Matrix::Transpose() const {
-  S21Matrix result(cols_, rows_);
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      result(j, i) = (*this)(i, j);
+template <typename T>
+void S21BasicMatrix<T>::TransposeInPlace() {
+  if (rows_ == cols_) {
+    // пары блоков (i, j) и (j, i) обмениваются через буфер на стеке
+    constexpr int kBlock = kTransposeBlock;
+    const int blocks = (rows_ + kBlock - 1) / kBlock;
+    s21_kernels::ParallelFor(0, blocks, Size(), [&](int from, int to) {
+      T tmp[kBlock * kBlock];
+      for (int ib = from * kBlock; ib < std::min(rows_, to * kBlock);
+           ib += kBlock) {
+        const int height = std::min(rows_ - ib, kBlock);
+        T *diagonal = matrix_ + static_cast<long>(ib) * stride_ + ib;
+        TransposeBlock(diagonal, stride_, tmp, kBlock, height, height);
+        CopyRows(tmp, kBlock, diagonal, stride_, height, height);
+        for (int jb = ib + kBlock; jb < cols_; jb += kBlock) {
+          const int width = std::min(cols_ - jb, kBlock);
+          T *upper = matrix_ + static_cast<long>(ib) * stride_ + jb;
+          T *lower = matrix_ + static_cast<long>(jb) * stride_ + ib;
+          TransposeBlock(upper, stride_, tmp, kBlock, height, width);
+          TransposeBlock(lower, stride_, upper, stride_, width, height);
+          CopyRows(tmp, kBlock, lower, stride_, width, height);
+        }
+      }
+    });
+  } else {
+    // строки сдвигаются вплотную, плотный массив переставляется по циклам
+    if (stride_ != cols_) {
+      for (int i = 1; i < rows_; ++i) {
+        const T *row = matrix_ + static_cast<long>(i) * stride_;
+        std::copy(row, row + cols_, matrix_ + static_cast<long>(i) * cols_);
+      }
     }
+    TransposeCycles(matrix_, rows_, cols_);
+    // шаг строк меняется, поэтому собственный буфер освобождается по
+    // запомненному размеру, как после release()
+    if (!deleter_) deleter_ = ResourceDeleter();
+    std::swap(rows_, cols_);
+    stride_ = cols_;
+    capacity_ = rows_;
   }
-  return result;
 }
 
-double S21Matrix::calc_determinant(int n) const {
-  double det = 0;
+template <typename T>
+T S21BasicMatrix<T>::calc_determinant(int n) const {
+  T det = T(0);
   if (n == 1) {
     // базовый случай: определитель матрицы 1x1 это единственный элемент
     det = (*this)(0, 0);
@@ -141,170 +520,372 @@ double S21Matrix::calc_determinant(int n) const {
     det = (*this)(0, 0) * (*this)(1, 1) - (*this)(0, 1) * (*this)(1, 0);
   } else {
     for (int j = 0; j < n; j++) {
-      S21Matrix minor = S21Matrix::MinorMatrix(0, j);
+      S21BasicMatrix minor = S21BasicMatrix::MinorMatrix(0, j);
       // рекурсивно вычислить определитель подматрицы
-      double sub_det = minor.calc_determinant(n - 1);
+      T sub_det = minor.calc_determinant(n - 1);
       // добавить к общему определителю учитывая знак
-      det += (j % 2 == 0 ? 1 : -1) * (*this)(0, j) * sub_det;
+      const T term = (*this)(0, j) * sub_det;
+      det += j % 2 == 0 ? term : -term;
     }
   }
   return det;
 }
 
-double S21Matrix::Determinant() const {
+template <typename T>
+T S21BasicMatrix<T>::Determinant() const {
   if (rows_ != cols_) {
     throw std::logic_error("Determinant: incorrect matrix size");
   }
-  return S21Matrix::calc_determinant(rows_);
+  T det = T(0);
+  if (rows_ <= kCofactorLimit) {
+    det = S21BasicMatrix::calc_determinant(rows_);
+  } else if constexpr (std::is_same<T, double>::value) {
+    det = S21LU(*this).Determinant();
+  } else {
+    det = GaussDeterminant(*this);
+  }
+  return det;
 }
 
 // версия для модификации
-double &S21Matrix::operator()(int row, int col) & {
+template <typename T>
+T &S21BasicMatrix<T>::operator()(int row, int col) & {
   if (row >= rows_ || col >= cols_ || row < 0 || col < 0)
     throw std::out_of_range("Index out of range");
-  return matrix_[row][col];
+  return matrix_[static_cast<long>(row) * stride_ + col];
 }
 
 // версия для чтения
-const double &S21Matrix::operator()(int row, int col) const & {
-  return matrix_[row][col];
+template <typename T>
+const T &S21BasicMatrix<T>::operator()(int row, int col) const & {
+  return matrix_[static_cast<long>(row) * stride_ + col];
 }
 
-S21Matrix S21Matrix::operator+(const S21Matrix &other) const {
-  S21Matrix tmp{*this};
-  tmp.SumMatrix(other);
-  return tmp;
-}
-
-S21Matrix S21Matrix::operator+=(const S21Matrix &other) {
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator+=(const S21BasicMatrix &other) {
   SumMatrix(other);
   return *this;
 }
 
-S21Matrix S21Matrix::operator-(const S21Matrix &other) const {
-  S21Matrix tmp{*this};
-  tmp.SubMatrix(other);
-  return tmp;
-}
-
-S21Matrix S21Matrix::operator-=(const S21Matrix &other) {
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator-=(const S21BasicMatrix &other) {
   SubMatrix(other);
   return *this;
 }
 
-S21Matrix S21Matrix::operator*(const S21Matrix &other) const {
-  S21Matrix tmp{*this};
-  tmp.MulMatrix(other);
-  return tmp;
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator*(
+    const S21BasicMatrix &other) const {
+  return Product(other);
 }
 
-S21Matrix S21Matrix::operator*=(const S21Matrix &other) {
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator*=(const S21BasicMatrix &other) {
   MulMatrix(other);
   return *this;
 }
 
-S21Matrix S21Matrix::operator*(double number) const {
-  S21Matrix tmp{*this};
-  tmp.MulNumber(number);
-  return tmp;
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator*=(T number) {
+  MulNumber(number);
+  return *this;
 }
 
-S21Matrix S21Matrix::operator*=(double number) {
-  MulNumber(number);
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator=(const S21BasicMatrix &other) {
+  if (this != &other) {
+    if (rows_ == other.rows_ && cols_ == other.cols_) {
+      for (int i = 0; i < rows_; i++) {
+        const T *src = other.matrix_ + static_cast<long>(i) * other.stride_;
+        std::copy(src, src + cols_, matrix_ + static_cast<long>(i) * stride_);
+      }
+    } else {
+      // новый буфер берётся из собственного ресурса
+      S21BasicMatrix tmp(other.rows_, other.cols_, resource_);
+      CopyRows(other.matrix_, other.stride_, tmp.matrix_, tmp.stride_,
+               tmp.rows_, tmp.cols_);
+      *this = std::move(tmp);
+    }
+  }
   return *this;
 }
 
-S21Matrix &S21Matrix::operator=(S21Matrix &&other) {
+template <typename T>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator=(
+    S21BasicMatrix &&other) noexcept {
   if (this != &other) {
     Free();
     rows_ = other.rows_;
     cols_ = other.cols_;
+    stride_ = other.stride_;
+    capacity_ = other.capacity_;
     matrix_ = other.matrix_;
+    resource_ = other.resource_;
+    deleter_.swap(other.deleter_);
 
     other.rows_ = 0;
     other.cols_ = 0;
+    other.stride_ = 0;
+    other.capacity_ = 0;
     other.matrix_ = nullptr;
   }
   return *this;
 }
 
-bool S21Matrix::operator==(const S21Matrix &other) const {
+template <typename T>
+bool S21BasicMatrix<T>::operator==(const S21BasicMatrix &other) const {
   return EqMatrix(other);
 }
 
-S21Matrix S21Matrix::CalcComplements() const {
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::CalcComplements() const {
   if (rows_ != cols_) {
     throw std::logic_error("CalcComplements: incorrect matrix size");
   }
 
-  S21Matrix result(rows_, cols_);
+  S21BasicMatrix result(rows_, cols_);
   for (int i = 0; i < rows_; ++i) {
     for (int j = 0; j < cols_; ++j) {
-      double minor = S21Matrix::calculate_minor(i, j);
-      result(i, j) = minor * pow(-1, i + j);
+      T minor = S21BasicMatrix::calculate_minor(i, j);
+      result(i, j) = (i + j) % 2 == 0 ? minor : -minor;
     }
   }
   return result;
 }
 
-double S21Matrix::calculate_minor(int i, int j) const {
-  double minor = 1;
+template <typename T>
+T S21BasicMatrix<T>::calculate_minor(int i, int j) const {
+  T minor = T(1);
   if (rows_ > 1) {
-    S21Matrix sub_matrix = S21Matrix::MinorMatrix(i, j);
+    S21BasicMatrix sub_matrix = S21BasicMatrix::MinorMatrix(i, j);
     minor = sub_matrix.Determinant();
     sub_matrix.Free();
   }
   return minor;
 }
 
-S21Matrix S21Matrix::InverseMatrix() const {
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::InverseMatrix() const {
   if (rows_ != cols_) {
     throw std::logic_error("InverseMatrix: incorrect matrix size");
   }
-  double det = S21Matrix::Determinant();
-  if (fabs(det) < EPSILON) {
-    throw std::logic_error("InverseMatrix: determinant must be non-zero");
+  // метод Гаусса-Жордана на месте в копии исходной матрицы:
+  // перестановка строк k и p в A соответствует перестановке
+  // столбцов k и p в обратной, её откатываем в конце
+  const int n = rows_;
+  S21BasicMatrix result(*this);
+  std::vector<int> pivots(n);
+  for (int k = 0; k < n; ++k) {
+    int pivot = k;
+    for (int i = k + 1; i < n; ++i) {
+      if (std::abs(result(i, k)) > std::abs(result(pivot, k))) pivot = i;
+    }
+    if (std::abs(result(pivot, k)) < EPSILON) {
+      throw std::logic_error("InverseMatrix: determinant must be non-zero");
+    }
+    pivots[k] = pivot;
+    T *row_k = result.matrix_ + static_cast<long>(k) * result.stride_;
+    if (pivot != k) {
+      T *row_pivot = result.matrix_ + static_cast<long>(pivot) * result.stride_;
+      std::swap_ranges(row_k, row_k + n, row_pivot);
+    }
+    const T inverse = T(1) / row_k[k];
+    row_k[k] = T(1);
+    for (int j = 0; j < n; ++j) row_k[j] *= inverse;
+    const long work = static_cast<long>(n) * n;
+    s21_kernels::ParallelFor(0, n, work, [&](int from, int to) {
+      for (int i = from; i < to; ++i) {
+        if (i == k) continue;
+        T *row_i = result.matrix_ + static_cast<long>(i) * result.stride_;
+        const T factor = row_i[k];
+        row_i[k] = T(0);
+        for (int j = 0; j < n; ++j) row_i[j] -= factor * row_k[j];
+      }
+    });
+  }
+  for (int k = n - 1; k >= 0; --k) {
+    if (pivots[k] == k) continue;
+    for (int i = 0; i < n; ++i) {
+      T *row_i = result.matrix_ + static_cast<long>(i) * result.stride_;
+      std::swap(row_i[k], row_i[pivots[k]]);
+    }
   }
-  S21Matrix complements = S21Matrix::CalcComplements();
-  S21Matrix transposed_matrix = complements.Transpose();
-  S21Matrix result = transposed_matrix * (1 / det);
   return result;
 }
 
-int S21Matrix::GetRows() const noexcept { return rows_; }
+template <typename T>
+long S21BasicMatrix<T>::Size() const noexcept {
+  return static_cast<long>(rows_) * cols_;
+}
+
+template <typename T>
+int S21BasicMatrix<T>::GetRows() const noexcept { return rows_; }
 
-int S21Matrix::GetCols() const noexcept { return cols_; }
+template <typename T>
+int S21BasicMatrix<T>::GetCols() const noexcept { return cols_; }
 
-void S21Matrix::SetRows(int rowValue) {
+template <typename T>
+void S21BasicMatrix<T>::SetRows(int rowValue) {
   if (rowValue < 0) {
     throw std::length_error("SetRows: can not set negative row value");
   }
   if (rowValue != rows_) {
-    int min = std::min(rows_, rowValue);
-    S21Matrix tmp(rowValue, cols_);
-    for (int i = 0; i < min; ++i) {
-      for (int j = 0; j < cols_; ++j) {
-        tmp(i, j) = (*this)(i, j);
-      }
+    if (deleter_ || rowValue > capacity_) {
+      // внешний буфер заменяется собственным без запаса
+      const int capacity = deleter_ ? std::max(rows_, rowValue)
+                                    : GrowCapacity(capacity_, rowValue);
+      *this = Reallocated(capacity, cols_);
+    } else if (rowValue > rows_) {
+      std::fill(matrix_ + static_cast<long>(rows_) * stride_,
+                matrix_ + static_cast<long>(rowValue) * stride_, T());
     }
-    *this = std::move(tmp);
-    tmp.Free();
+    rows_ = rowValue;
   }
 }
 
-void S21Matrix::SetCols(int colValue) {
+template <typename T>
+void S21BasicMatrix<T>::SetCols(int colValue) {
   if (colValue < 0) {
     throw std::length_error("SetCols: can not set negative col value");
   }
   if (colValue != cols_) {
-    int min = std::min(cols_, colValue);
-    S21Matrix tmp(rows_, colValue);
-    for (int i = 0; i < rows_; ++i) {
-      for (int j = 0; j < min; ++j) {
-        tmp(i, j) = (*this)(i, j);
+    if (deleter_ || colValue > stride_) {
+      const int cols = deleter_ ? std::max(cols_, colValue)
+                                : GrowCapacity(stride_, colValue);
+      *this = Reallocated(deleter_ ? rows_ : capacity_, cols);
+    } else if (colValue > cols_) {
+      for (int i = 0; i < rows_; ++i) {
+        T *row = matrix_ + static_cast<long>(i) * stride_;
+        std::fill(row + cols_, row + colValue, T());
       }
     }
-    *this = std::move(tmp);
-    tmp.Free();
+    cols_ = colValue;
+  }
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Reallocated(int capacity,
+                                                 int cols) const {
+  S21BasicMatrix result(capacity, cols, resource_);
+  CopyRows(matrix_, stride_, result.matrix_, result.stride_, rows_, cols_);
+  result.rows_ = rows_;
+  result.cols_ = cols_;
+  return result;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::reserve(int rows, int cols) {
+  if (rows < 0 || cols < 0) {
+    throw std::length_error("reserve: can not reserve negative size");
+  }
+  if (rows > capacity_ || cols > stride_) {
+    *this = Reallocated(std::max(rows, capacity_), std::max(cols, stride_));
+  }
+}
+
+template <typename T>
+void S21BasicMatrix<T>::shrink_to_fit() {
+  if (!deleter_ &&
+      (capacity_ != rows_ || stride_ != PaddedStride<T>(cols_))) {
+    *this = Reallocated(rows_, cols_);
   }
-}
\ No newline at end of file
+}
+
+template <typename T>
+int S21BasicMatrix<T>::capacity() const noexcept { return capacity_; }
+
+template <typename T>
+void S21BasicMatrix<T>::AppendRow(const T *values) {
+  if (deleter_ || rows_ == capacity_) {
+    // values читаются до освобождения старого буфера
+    S21BasicMatrix grown =
+        Reallocated(GrowCapacity(capacity_, rows_ + 1), cols_);
+    std::copy(values, values + cols_,
+              grown.matrix_ + static_cast<long>(rows_) * grown.stride_);
+    *this = std::move(grown);
+  } else {
+    std::copy(values, values + cols_,
+              matrix_ + static_cast<long>(rows_) * stride_);
+  }
+  ++rows_;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::AppendCol(const T *values) {
+  const bool grow = deleter_ || cols_ == stride_;
+  S21BasicMatrix grown;
+  if (grow) grown = Reallocated(capacity_, GrowCapacity(stride_, cols_ + 1));
+  S21BasicMatrix &target = grow ? grown : *this;
+  for (int i = 0; i < rows_; ++i) {
+    target.matrix_[static_cast<long>(i) * target.stride_ + cols_] = values[i];
+  }
+  if (grow) *this = std::move(grown);
+  ++cols_;
+}
+
+template <typename T>
+T *S21BasicMatrix<T>::data() noexcept { return matrix_; }
+
+template <typename T>
+const T *S21BasicMatrix<T>::data() const noexcept { return matrix_; }
+
+template <typename T>
+int S21BasicMatrix<T>::stride() const noexcept { return stride_; }
+
+template <typename T>
+std::pmr::memory_resource *S21BasicMatrix<T>::GetResource() const noexcept {
+  return resource_;
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::View() & {
+  return {matrix_, rows_, cols_, stride_};
+}
+
+template <typename T>
+S21BasicMatrixView<const T> S21BasicMatrix<T>::View() const & {
+  return {matrix_, rows_, cols_, stride_};
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::Block(int row, int col, int rows,
+                                               int cols) & {
+  return View().Block(row, col, rows, cols);
+}
+
+template <typename T>
+S21BasicMatrixView<const T> S21BasicMatrix<T>::Block(int row, int col,
+                                                     int rows,
+                                                     int cols) const & {
+  return View().Block(row, col, rows, cols);
+}
+
+template <typename T>
+S21BasicMatrix<T> S21MulMatrix(S21BasicMatrixView<const T> lhs,
+                               S21BasicMatrixView<const T> rhs) {
+  if (lhs.GetCols() != rhs.GetRows()) {
+    throw std::logic_error("MulMatrix: incorrect matrix size");
+  }
+  S21BasicMatrix<T> result(lhs.GetRows(), rhs.GetCols());
+  if constexpr (std::is_same<T, double>::value) {
+    S21MulAdd(lhs, rhs, result.View());
+  } else {
+    LoopMulAdd(lhs, rhs, result.View());
+  }
+  return result;
+}
+
+template class S21BasicMatrix<float>;
+template class S21BasicMatrix<double>;
+template class S21BasicMatrix<long double>;
+template class S21BasicMatrix<std::complex<double>>;
+
+template S21MatrixF S21MulMatrix(S21BasicMatrixView<const float>,
+                                 S21BasicMatrixView<const float>);
+template S21Matrix S21MulMatrix(S21BasicMatrixView<const double>,
+                                S21BasicMatrixView<const double>);
+template S21MatrixLD S21MulMatrix(S21BasicMatrixView<const long double>,
+                                  S21BasicMatrixView<const long double>);
+template S21MatrixC S21MulMatrix(
+    S21BasicMatrixView<const std::complex<double>>,
+    S21BasicMatrixView<const std::complex<double>>);
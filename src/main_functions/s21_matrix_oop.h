@@ -1,50 +1,307 @@
 #ifndef S21_MATRIX_OOP_H_
 #define S21_MATRIX_OOP_H_
 
-class S21Matrix {
+#include <complex>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+
+#include "s21_matrix_expr.h"
+#include "s21_matrix_memory.h"
+#include "s21_matrix_parallel.h"
+#include "s21_matrix_view.h"
+
+// порядок элементов во внешнем буфере
+enum class S21Layout { kRowMajor, kColMajor };
+
+// Допуск сравнения матриц и порог вырожденности для типа элементов.
+// Для комплексных чисел сравнивается модуль разности.
+template <typename T>
+struct S21Tolerance {
+  static constexpr T kValue = T(1e-7);
+};
+template <>
+struct S21Tolerance<float> {
+  static constexpr float kValue = 1e-4f;
+};
+template <>
+struct S21Tolerance<long double> {
+  static constexpr long double kValue = 1e-10L;
+};
+template <typename T>
+struct S21Tolerance<std::complex<T>> : S21Tolerance<T> {};
+
+// Матрица с элементами типа T. Реализация скомпилирована для float,
+// double, long double и std::complex<double>; векторные ядра
+// используются для double (все операции) и float (поэлементные).
+template <typename T>
+class S21BasicMatrix : public S21MatrixExpr<S21BasicMatrix<T>> {
+ public:
+  using value_type = T;
+  using Deleter = std::function<void(T *)>;
+  using Buffer = std::unique_ptr<T[], Deleter>;
+
  private:
   int rows_, cols_;
-  double **matrix_;
-  const double EPSILON = 1e-7;
+  // шаг между началами строк (в элементах), >= cols_
+  int stride_;
+  // строк, под которые выделен буфер (>= rows_); ёмкость по столбцам -
+  // stride_
+  int capacity_;
+  // строки лежат подряд в одном выровненном буфере
+  T *matrix_;
+  // откуда выделен буфер и куда он будет возвращён
+  std::pmr::memory_resource *resource_;
+  // задан, если буфер внешний: вызывается вместо возврата в resource_
+  Deleter deleter_;
+  static constexpr auto EPSILON = S21Tolerance<T>::kValue;
   void Free() noexcept;
-  S21Matrix MinorMatrix(const int skip_row, const int skip_column) const;
-  double calc_determinant(int n) const;
-  double calculate_minor(int i, int j) const;
+  // возвращает буфер текущего размера в resource_
+  Deleter ResourceDeleter() const;
+  // копия в собственном буфере на capacity строк и не меньше cols
+  // столбцов
+  S21BasicMatrix Reallocated(int capacity, int cols) const;
+  // число элементов - оценка объёма поэлементных операций
+  long Size() const noexcept;
+  S21BasicMatrix MinorMatrix(const int skip_row, const int skip_column) const;
+  T calc_determinant(int n) const;
+  T calculate_minor(int i, int j) const;
+  // произведение в новую матрицу без копии *this
+  S21BasicMatrix Product(const S21BasicMatrix &other) const;
+  // поэлементно: this(i, j) = op(this(i, j), expr(i, j)) за один проход
+  template <typename E, typename Op>
+  void Evaluate(const E &expr, Op op);
+  // вид-лист выражения смотрит в буфер *this (например, транспонированный
+  // или сдвинутый): на месте вычислять нельзя
+  template <typename E>
+  bool Aliases(const E &expr) const noexcept;
 
  public:
-  S21Matrix();
-  explicit S21Matrix(int rows, int cols);
-  S21Matrix(const S21Matrix &other);
-  S21Matrix(S21Matrix &&other) noexcept;
-  ~S21Matrix();
+  S21BasicMatrix();
+  explicit S21BasicMatrix(int rows, int cols);
+  // буфер выделяется из resource (по умолчанию - S21GetMemoryResource())
+  S21BasicMatrix(int rows, int cols, std::pmr::memory_resource *resource);
+  S21BasicMatrix(const S21BasicMatrix &other);
+  S21BasicMatrix(S21BasicMatrix &&other) noexcept;
+  // вычисление ленивого выражения сразу в новую матрицу
+  template <typename E>
+  S21BasicMatrix(const S21MatrixExpr<E> &expr);
+  ~S21BasicMatrix();
+
+  // Матрица над внешним буфером без копирования. stride - шаг строк
+  // (0 - плотно). Adopt забирает владение, буфер освобождается вызовом
+  // deleter; буфер по столбцам переставляется на месте в построчный
+  // (только плотный). Borrow не владеет буфером, и он должен пережить
+  // матрицу; для буфера по столбцам используйте S21ConstMatrixView.
+  // Изменение размера переносит данные в собственный буфер.
+  static S21BasicMatrix Adopt(T *data, int rows, int cols, Deleter deleter,
+                              S21Layout layout = S21Layout::kRowMajor,
+                              int stride = 0);
+  static S21BasicMatrix Borrow(T *data, int rows, int cols,
+                               S21Layout layout = S21Layout::kRowMajor,
+                               int stride = 0);
+  // отдаёт буфер (шаг строк - stride()) вместе с освобождающей функцией,
+  // матрица становится пустой
+  Buffer release();
 
   int GetRows() const noexcept;
   int GetCols() const noexcept;
+  // Размер меняется на месте, пока помещается в выделенный буфер:
+  // уменьшение ничего не перевыделяет, открывшиеся при росте элементы
+  // нулевые. Не поместившийся размер выделяется с запасом (вдвое), как
+  // в std::vector, поэтому рост по одной строке стоит амортизированно O(1).
   void SetRows(int rowValue);
   void SetCols(int colValue);
+  // ёмкость не меньше rows x cols; размер не меняется
+  void reserve(int rows, int cols);
+  // отдаёт запас, буфер становится ровно по размеру
+  void shrink_to_fit();
+  // строк, помещающихся без перевыделения; столбцов - stride()
+  int capacity() const noexcept;
+  // добавляют строку из GetCols() значений или столбец из GetRows()
+  // значений; values может указывать в саму матрицу
+  void AppendRow(const T *values);
+  void AppendCol(const T *values);
+
+  T *data() noexcept;
+  const T *data() const noexcept;
+  int stride() const noexcept;
+  std::pmr::memory_resource *GetResource() const noexcept;
+  // невладеющие виды на буфер матрицы, см. s21_matrix_view.h
+  S21BasicMatrixView<T> View() &;
+  S21BasicMatrixView<const T> View() const &;
+  S21BasicMatrixView<T> Block(int row, int col, int rows, int cols) &;
+  S21BasicMatrixView<const T> Block(int row, int col, int rows,
+                                    int cols) const &;
+
+  bool EqMatrix(const S21BasicMatrix &other) const;
+  void SumMatrix(const S21BasicMatrix &other);
+  void SubMatrix(const S21BasicMatrix &other);
+  void MulNumber(const T num);
+  void MulMatrix(const S21BasicMatrix &other);
+  // умножение на транспонированную: this = this * other^T
+  void MulTransposedMatrix(const S21BasicMatrix &other);
+  S21BasicMatrix Transpose() const;
+  // Транспонирование без второй матрицы. Квадратная переставляется
+  // блоками на месте. Прямоугольная сжимается до плотного буфера
+  // (шаг строк = GetCols()) и переставляется по циклам перестановки с
+  // битовой картой в 1/8 байта на элемент; её буфер дальше ведёт себя как
+  // внешний - изменение размера переносит данные в собственный.
+  void TransposeInPlace();
+  S21BasicMatrix CalcComplements() const;
+  T Determinant() const;
+  S21BasicMatrix InverseMatrix() const;
 
-  bool EqMatrix(const S21Matrix &other) const;
-  void SumMatrix(const S21Matrix &other);
-  void SubMatrix(const S21Matrix &other);
-  void MulNumber(const double num);
-  void MulMatrix(const S21Matrix &other);
-  S21Matrix Transpose() const;
-  S21Matrix CalcComplements() const;
-  double Determinant() const;
-  S21Matrix InverseMatrix() const;
-
-  S21Matrix operator*(const S21Matrix &other) const;
-  S21Matrix operator*(double number) const;
-  S21Matrix operator+(const S21Matrix &other) const;
-  S21Matrix operator-(const S21Matrix &other) const;
-  bool operator==(const S21Matrix &other) const;
-  S21Matrix &operator=(S21Matrix &&other);
-  S21Matrix operator+=(const S21Matrix &other);
-  S21Matrix operator-=(const S21Matrix &other);
-  S21Matrix operator*=(const S21Matrix &other);
-  S21Matrix operator*=(double number);
-  double &operator()(int row, int col) &;
-  const double &operator()(int row, int col) const &;
+  S21BasicMatrix operator*(const S21BasicMatrix &other) const;
+  bool operator==(const S21BasicMatrix &other) const;
+  // при совпадении размеров копирует в уже выделенный буфер
+  S21BasicMatrix &operator=(const S21BasicMatrix &other);
+  S21BasicMatrix &operator=(S21BasicMatrix &&other) noexcept;
+  template <typename E>
+  S21BasicMatrix &operator=(const S21MatrixExpr<E> &expr);
+  template <typename E>
+  S21BasicMatrix &operator+=(const S21MatrixExpr<E> &expr);
+  template <typename E>
+  S21BasicMatrix &operator-=(const S21MatrixExpr<E> &expr);
+  S21BasicMatrix &operator+=(const S21BasicMatrix &other);
+  S21BasicMatrix &operator-=(const S21BasicMatrix &other);
+  S21BasicMatrix &operator*=(const S21BasicMatrix &other);
+  S21BasicMatrix &operator*=(T number);
+  T &operator()(int row, int col) &;
+  const T &operator()(int row, int col) const &;
 };
 
-#endif  // S21_MATRIX_OOP_H_
\ No newline at end of file
+using S21Matrix = S21BasicMatrix<double>;
+using S21MatrixF = S21BasicMatrix<float>;
+using S21MatrixLD = S21BasicMatrix<long double>;
+using S21MatrixC = S21BasicMatrix<std::complex<double>>;
+
+extern template class S21BasicMatrix<float>;
+extern template class S21BasicMatrix<double>;
+extern template class S21BasicMatrix<long double>;
+extern template class S21BasicMatrix<std::complex<double>>;
+
+template <typename T>
+template <typename E, typename Op>
+void S21BasicMatrix<T>::Evaluate(const E &expr, Op op) {
+  s21_kernels::ParallelFor(0, rows_, Size(), [&](int from, int to) {
+    for (int i = from; i < to; ++i) {
+      T *row = matrix_ + static_cast<long>(i) * stride_;
+      for (int j = 0; j < cols_; ++j) row[j] = op(row[j], expr(i, j));
+    }
+  });
+}
+
+template <typename T>
+template <typename E>
+bool S21BasicMatrix<T>::Aliases(const E &expr) const noexcept {
+  return matrix_ &&
+         s21_expr::Aliases(expr, matrix_,
+                           matrix_ + static_cast<long>(capacity_) * stride_);
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>::S21BasicMatrix(const S21MatrixExpr<E> &expr)
+    : S21BasicMatrix(expr.GetRows(), expr.GetCols()) {
+  Evaluate(expr.Self(), [](T, T value) { return value; });
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator=(const S21MatrixExpr<E> &expr) {
+  if (rows_ != expr.GetRows() || cols_ != expr.GetCols() ||
+      Aliases(expr.Self())) {
+    // новая матрица: *this другого размера или виден через вид
+    *this = S21BasicMatrix(expr);
+  } else {
+    // совпадающие элементы читаются до записи, поэтому A = A + B безопасно
+    Evaluate(expr.Self(), [](T, T value) { return value; });
+  }
+  return *this;
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator+=(
+    const S21MatrixExpr<E> &expr) {
+  s21_expr::CheckSameSize(*this, expr, "SumMatrix: Incorrect matrix size");
+  if (Aliases(expr.Self())) {
+    Evaluate(S21BasicMatrix(expr), s21_expr::Plus::Apply<T>);
+  } else {
+    Evaluate(expr.Self(), s21_expr::Plus::Apply<T>);
+  }
+  return *this;
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrix<T> &S21BasicMatrix<T>::operator-=(
+    const S21MatrixExpr<E> &expr) {
+  s21_expr::CheckSameSize(*this, expr, "SubMatrix: Incorrect matrix size");
+  if (Aliases(expr.Self())) {
+    Evaluate(S21BasicMatrix(expr), s21_expr::Minus::Apply<T>);
+  } else {
+    Evaluate(expr.Self(), s21_expr::Minus::Apply<T>);
+  }
+  return *this;
+}
+
+// произведение видов без копирования операндов
+template <typename T>
+S21BasicMatrix<T> S21MulMatrix(S21BasicMatrixView<const T> lhs,
+                               S21BasicMatrixView<const T> rhs);
+
+// виды на изменяемые данные приводятся к видам только для чтения
+template <typename L, typename R>
+S21BasicMatrix<std::remove_const_t<L>> S21MulMatrix(S21BasicMatrixView<L> lhs,
+                                                    S21BasicMatrixView<R> rhs) {
+  using T = std::remove_const_t<L>;
+  return S21MulMatrix(S21BasicMatrixView<const T>(lhs),
+                      S21BasicMatrixView<const T>(rhs));
+}
+
+namespace s21_expr {
+
+// матрицы и виды умножаются на месте, прочие выражения - после вычисления
+template <typename T>
+constexpr bool kIsLeaf = kIsMatrix<T> || kIsView<T>;
+
+template <typename T>
+S21BasicMatrixView<const T> AsView(const S21BasicMatrix<T> &matrix) {
+  return matrix.View();
+}
+
+template <typename T>
+S21BasicMatrixView<const std::remove_const_t<T>> AsView(
+    const S21BasicMatrixView<T> &view) {
+  return view;
+}
+
+}  // namespace s21_expr
+
+// произведение и сравнение с участием выражений; для двух матриц
+// выбираются члены класса. Операнды принимаются как const L &, чтобы
+// не конкурировать с членами класса при смешанных типах.
+template <typename L, typename R,
+          typename = std::enable_if_t<s21_expr::kIsExpr<L> &&
+                                      s21_expr::kIsExpr<R>>>
+S21BasicMatrix<typename L::value_type> operator*(const L &lhs, const R &rhs) {
+  using Matrix = S21BasicMatrix<typename L::value_type>;
+  if constexpr (!s21_expr::kIsLeaf<L>) {
+    return Matrix(lhs) * rhs;
+  } else if constexpr (!s21_expr::kIsLeaf<R>) {
+    return lhs * Matrix(rhs);
+  } else {
+    return S21MulMatrix(s21_expr::AsView(lhs), s21_expr::AsView(rhs));
+  }
+}
+
+template <typename L, typename R,
+          typename = std::enable_if_t<s21_expr::kIsExpr<L> &&
+                                      s21_expr::kIsExpr<R>>>
+bool operator==(const L &lhs, const R &rhs) {
+  return S21BasicMatrix<typename L::value_type>(lhs).EqMatrix(rhs);
+}
+
+#endif  // S21_MATRIX_OOP_H_
@@ -0,0 +1,156 @@
+#include "s21_matrix_parallel.h"
+
+#include <algorithm>           // std::min
+#include <atomic>              // std::atomic
+#include <condition_variable>  // std::condition_variable
+#include <deque>               // std::deque
+#include <exception>           // std::exception_ptr
+#include <functional>          // std::function
+#include <memory>              // std::shared_ptr
+#include <mutex>               // std::mutex
+#include <stdexcept>           // length_error
+#include <thread>              // std::thread
+#include <vector>              // std::vector
+
+namespace {
+constexpr long kDefaultThreshold = 1L << 16;
+
+class ThreadPool {
+ private:
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> jobs_;
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  bool stop_ = false;
+
+  void Loop() {
+    s21_kernels::InParallelRegion() = true;
+    for (;;) {
+      std::function<void()> job;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+        if (jobs_.empty()) break;
+        job = std::move(jobs_.front());
+        jobs_.pop_front();
+      }
+      job();
+    }
+  }
+
+ public:
+  explicit ThreadPool(int threads) {
+    for (int i = 0; i < threads; ++i) workers_.emplace_back([this] { Loop(); });
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    ready_.notify_all();
+    for (std::thread &worker : workers_) worker.join();
+  }
+
+  void Submit(std::function<void()> job) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      jobs_.push_back(std::move(job));
+    }
+    ready_.notify_one();
+  }
+};
+
+struct ParallelState {
+  std::mutex mutex;
+  // пул из threads - 1 рабочих: вызывающий поток считает свой кусок сам
+  std::shared_ptr<ThreadPool> pool;
+  std::atomic<int> threads{1};
+  std::atomic<long> threshold{kDefaultThreshold};
+};
+
+ParallelState &State() {
+  static ParallelState state;
+  return state;
+}
+
+// счётчик незавершённых кусков одного вызова ParallelFor
+struct Barrier {
+  std::mutex mutex;
+  std::condition_variable done;
+  int pending;
+  std::exception_ptr error;
+};
+
+void RunChunk(s21_kernels::RangeBody body, const void *context, int from,
+              int to, Barrier &barrier) {
+  std::exception_ptr error;
+  try {
+    body(context, from, to);
+  } catch (...) {
+    error = std::current_exception();
+  }
+  std::lock_guard<std::mutex> lock(barrier.mutex);
+  if (error && !barrier.error) barrier.error = error;
+  if (--barrier.pending == 0) barrier.done.notify_all();
+}
+}  // namespace
+
+void S21SetNumThreads(int threads) {
+  if (threads < 0) {
+    throw std::length_error("S21SetNumThreads: negative thread count");
+  }
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  ParallelState &state = State();
+  std::shared_ptr<ThreadPool> pool;
+  if (threads > 1) pool = std::make_shared<ThreadPool>(threads - 1);
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.pool.swap(pool);
+  state.threads.store(threads);
+}
+
+int S21GetNumThreads() noexcept { return State().threads.load(); }
+
+void S21SetParallelThreshold(long work) { State().threshold.store(work); }
+
+long S21GetParallelThreshold() noexcept { return State().threshold.load(); }
+
+namespace s21_kernels {
+
+bool &InParallelRegion() noexcept {
+  thread_local bool in_region = false;
+  return in_region;
+}
+
+void ParallelForRange(int begin, int end, long work, RangeBody body,
+                      const void *context) {
+  ParallelState &state = State();
+  const int count = end - begin;
+  int chunks = std::min(state.threads.load(), count);
+  std::shared_ptr<ThreadPool> pool;
+  if (chunks > 1 && work >= state.threshold.load() && !InParallelRegion()) {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    pool = state.pool;
+  }
+  if (!pool) {
+    if (count > 0) body(context, begin, end);
+    return;
+  }
+  Barrier barrier;
+  barrier.pending = chunks;
+  for (int chunk = 1; chunk < chunks; ++chunk) {
+    const int from = begin + static_cast<long>(count) * chunk / chunks;
+    const int to = begin + static_cast<long>(count) * (chunk + 1) / chunks;
+    pool->Submit([body, context, &barrier, from, to] {
+      RunChunk(body, context, from, to, barrier);
+    });
+  }
+  RunChunk(body, context, begin, begin + count / chunks, barrier);
+  std::unique_lock<std::mutex> lock(barrier.mutex);
+  barrier.done.wait(lock, [&barrier] { return barrier.pending == 0; });
+  if (barrier.error) std::rethrow_exception(barrier.error);
+}
+
+}  // namespace s21_kernels
@@ -0,0 +1,43 @@
+#ifndef S21_MATRIX_PARALLEL_H_
+#define S21_MATRIX_PARALLEL_H_
+
+// Число потоков, которыми библиотека выполняет умножение, транспонирование,
+// поэлементные операции и разложения. По умолчанию 1 - всё выполняется
+// в вызывающем потоке; 0 означает std::thread::hardware_concurrency().
+void S21SetNumThreads(int threads);
+int S21GetNumThreads() noexcept;
+
+// Операции с меньшим объёмом работы (примерно в умножениях-сложениях)
+// выполняются последовательно, чтобы не платить за синхронизацию.
+void S21SetParallelThreshold(long work);
+long S21GetParallelThreshold() noexcept;
+
+namespace s21_kernels {
+
+using RangeBody = void (*)(const void *context, int from, int to);
+
+void ParallelForRange(int begin, int end, long work, RangeBody body,
+                      const void *context);
+
+// Делит [begin, end) на непрерывные куски и вызывает body(from, to)
+// для каждого на пуле потоков библиотеки; вызывающий поток тоже
+// участвует и дожидается завершения всех кусков. Вложенные вызовы
+// из рабочих потоков выполняются последовательно. Тело передаётся
+// по указателю, поэтому последовательный путь не выделяет память.
+template <typename Body>
+void ParallelFor(int begin, int end, long work, const Body &body) {
+  ParallelForRange(
+      begin, end, work,
+      [](const void *context, int from, int to) {
+        (*static_cast<const Body *>(context))(from, to);
+      },
+      &body);
+}
+
+// true, пока поток выполняет кусок ParallelFor или задачу планировщика;
+// вложенные параллельные вызовы в этом случае идут последовательно
+bool &InParallelRegion() noexcept;
+
+}  // namespace s21_kernels
+
+#endif  // S21_MATRIX_PARALLEL_H_
@@ -0,0 +1,249 @@
+#include "s21_matrix_scheduler.h"
+
+#include <atomic>              // std::atomic
+#include <condition_variable>  // std::condition_variable
+#include <exception>           // std::exception_ptr
+#include <mutex>               // std::mutex
+#include <stdexcept>           // logic_error
+#include <thread>              // std::thread
+
+#include "s21_matrix_parallel.h"
+
+namespace s21_kernels {
+
+struct TaskGraph::Task {
+  std::function<void()> work;
+  std::vector<Task *> successors;
+  int dependencies = 0;
+  std::atomic<int> pending{0};
+};
+
+}  // namespace s21_kernels
+
+namespace {
+using Task = s21_kernels::TaskGraph::Task;
+
+constexpr long kDequeCapacity = 1 << 12;
+
+// Дек Чейза-Лева: владелец кладёт и забирает задачи с нижнего конца
+// без блокировок, остальные потоки крадут с верхнего через CAS.
+// Ёмкость фиксирована: если дек полон, задача выполняется сразу.
+class WorkDeque {
+ private:
+  std::atomic<long> top_{0};
+  std::atomic<long> bottom_{0};
+  std::vector<std::atomic<Task *>> buffer_;
+
+ public:
+  WorkDeque() : buffer_(kDequeCapacity) {}
+
+  bool Push(Task *task) {
+    const long bottom = bottom_.load(std::memory_order_relaxed);
+    const long top = top_.load(std::memory_order_acquire);
+    bool pushed = bottom - top < kDequeCapacity;
+    if (pushed) {
+      buffer_[bottom & (kDequeCapacity - 1)].store(task,
+                                                   std::memory_order_relaxed);
+      bottom_.store(bottom + 1);
+    }
+    return pushed;
+  }
+
+  Task *Pop() {
+    const long bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(bottom);
+    long top = top_.load();
+    Task *task = nullptr;
+    if (top <= bottom) {
+      task = buffer_[bottom & (kDequeCapacity - 1)].load(
+          std::memory_order_relaxed);
+      if (top == bottom) {
+        // последний элемент: соревнуемся с ворами
+        if (!top_.compare_exchange_strong(top, top + 1)) task = nullptr;
+        bottom_.store(bottom + 1);
+      }
+    } else {
+      bottom_.store(bottom + 1);
+    }
+    return task;
+  }
+
+  Task *Steal() {
+    long top = top_.load();
+    const long bottom = bottom_.load();
+    Task *task = nullptr;
+    if (top < bottom) {
+      task = buffer_[top & (kDequeCapacity - 1)].load(
+          std::memory_order_relaxed);
+      if (!top_.compare_exchange_strong(top, top + 1)) task = nullptr;
+    }
+    return task;
+  }
+};
+
+// Постоянные рабочие потоки планировщика; дек 0 принадлежит потоку,
+// вызвавшему Run.
+class Scheduler {
+ private:
+  int threads_;
+  std::vector<std::unique_ptr<WorkDeque>> deques_;
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  bool stop_ = false;
+  std::atomic<bool> active_{false};
+  std::atomic<int> remaining_{0};
+  std::mutex error_mutex_;
+  std::exception_ptr error_;
+
+  void Execute(Task *task, int index) {
+    try {
+      task->work();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(error_mutex_);
+      if (!error_) error_ = std::current_exception();
+    }
+    for (Task *successor : task->successors) {
+      if (successor->pending.fetch_sub(1) == 1 &&
+          !deques_[index]->Push(successor)) {
+        Execute(successor, index);
+      }
+    }
+    remaining_.fetch_sub(1);
+  }
+
+  bool RunOne(int index) {
+    Task *task = deques_[index]->Pop();
+    for (int shift = 1; shift < threads_ && !task; ++shift) {
+      task = deques_[(index + shift) % threads_]->Steal();
+    }
+    if (task) Execute(task, index);
+    return task != nullptr;
+  }
+
+  void Loop(int index) {
+    s21_kernels::InParallelRegion() = true;
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [this] { return stop_ || active_.load(); });
+        if (stop_) break;
+      }
+      while (active_.load()) {
+        if (!RunOne(index)) std::this_thread::yield();
+      }
+    }
+  }
+
+ public:
+  explicit Scheduler(int threads) : threads_(threads) {
+    for (int i = 0; i < threads_; ++i) {
+      deques_.push_back(std::make_unique<WorkDeque>());
+    }
+    for (int i = 1; i < threads_; ++i) {
+      workers_.emplace_back([this, i] { Loop(i); });
+    }
+  }
+
+  ~Scheduler() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread &worker : workers_) worker.join();
+  }
+
+  int GetThreads() const noexcept { return threads_; }
+
+  void Run(const std::vector<Task *> &roots, int total) {
+    error_ = nullptr;
+    remaining_.store(total);
+    for (Task *root : roots) {
+      if (!deques_[0]->Push(root)) Execute(root, 0);
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      active_.store(true);
+    }
+    wake_.notify_all();
+    bool &in_region = s21_kernels::InParallelRegion();
+    in_region = true;
+    while (remaining_.load() > 0) {
+      if (!RunOne(0)) std::this_thread::yield();
+    }
+    in_region = false;
+    active_.store(false);
+    if (error_) std::rethrow_exception(error_);
+  }
+};
+
+// один граф выполняется планировщиком за раз
+std::mutex scheduler_mutex;
+
+Scheduler &SharedScheduler(int threads) {
+  static std::unique_ptr<Scheduler> scheduler;
+  if (!scheduler || scheduler->GetThreads() != threads) {
+    scheduler.reset();
+    scheduler = std::make_unique<Scheduler>(threads);
+  }
+  return *scheduler;
+}
+
+// выполнение в вызывающем потоке в топологическом порядке
+void RunSerial(const std::vector<Task *> &roots) {
+  std::vector<Task *> ready(roots.rbegin(), roots.rend());
+  while (!ready.empty()) {
+    Task *task = ready.back();
+    ready.pop_back();
+    task->work();
+    for (auto it = task->successors.rbegin(); it != task->successors.rend();
+         ++it) {
+      if (--(*it)->pending == 0) ready.push_back(*it);
+    }
+  }
+}
+}  // namespace
+
+namespace s21_kernels {
+
+TaskGraph::TaskGraph() = default;
+
+TaskGraph::~TaskGraph() = default;
+
+TaskGraph::TaskId TaskGraph::Add(std::function<void()> work,
+                                 const std::vector<TaskId> &dependencies) {
+  const TaskId id = static_cast<TaskId>(tasks_.size());
+  auto task = std::make_unique<Task>();
+  task->work = std::move(work);
+  for (TaskId dependency : dependencies) {
+    if (dependency < 0 || dependency >= id) {
+      throw std::logic_error("TaskGraph: unknown dependency");
+    }
+    tasks_[dependency]->successors.push_back(task.get());
+    ++task->dependencies;
+  }
+  tasks_.push_back(std::move(task));
+  return id;
+}
+
+int TaskGraph::GetSize() const noexcept {
+  return static_cast<int>(tasks_.size());
+}
+
+void TaskGraph::Run() {
+  std::vector<Task *> roots;
+  for (const auto &task : tasks_) {
+    task->pending.store(task->dependencies);
+    if (task->dependencies == 0) roots.push_back(task.get());
+  }
+  const int threads = S21GetNumThreads();
+  if (threads <= 1 || InParallelRegion()) {
+    RunSerial(roots);
+  } else {
+    std::lock_guard<std::mutex> lock(scheduler_mutex);
+    SharedScheduler(threads).Run(roots, GetSize());
+  }
+}
+
+}  // namespace s21_kernels
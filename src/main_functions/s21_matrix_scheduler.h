@@ -0,0 +1,39 @@
+#ifndef S21_MATRIX_SCHEDULER_H_
+#define S21_MATRIX_SCHEDULER_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace s21_kernels {
+
+// Граф задач над блоками матрицы. Задача запускается, когда выполнены
+// все её зависимости, поэтому, например, факторизация следующей панели
+// LU начинается сразу после обновления её столбца, не дожидаясь
+// остальных обновлений шага.
+class TaskGraph {
+ public:
+  using TaskId = int;
+
+  TaskGraph();
+  ~TaskGraph();
+  TaskGraph(const TaskGraph &) = delete;
+  TaskGraph &operator=(const TaskGraph &) = delete;
+
+  // зависимости должны быть добавлены в граф раньше
+  TaskId Add(std::function<void()> work,
+             const std::vector<TaskId> &dependencies = {});
+  int GetSize() const noexcept;
+  // выполняет все задачи на S21GetNumThreads() потоках с кражей работы;
+  // вызывающий поток участвует, первое исключение задачи пробрасывается
+  void Run();
+
+  struct Task;
+
+ private:
+  std::vector<std::unique_ptr<Task>> tasks_;
+};
+
+}  // namespace s21_kernels
+
+#endif  // S21_MATRIX_SCHEDULER_H_
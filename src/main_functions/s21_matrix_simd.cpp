@@ -0,0 +1,643 @@
+#include "s21_matrix_simd.h"
+
+#include <atomic>     // std::atomic
+#include <cmath>      // std::abs
+#include <stdexcept>  // logic_error
+
+#if defined(__x86_64__) || defined(__i386__)
+#define S21_SIMD_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define S21_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+using s21_kernels::kGemmMR;
+using s21_kernels::kGemmNR;
+using s21_kernels::SimdTable;
+
+template <typename T>
+void ScalarAdd(T *dst, const T *src, int n) {
+  for (int i = 0; i < n; ++i) dst[i] += src[i];
+}
+
+template <typename T>
+void ScalarSub(T *dst, const T *src, int n) {
+  for (int i = 0; i < n; ++i) dst[i] -= src[i];
+}
+
+template <typename T>
+void ScalarScale(T *dst, T value, int n) {
+  for (int i = 0; i < n; ++i) dst[i] *= value;
+}
+
+void ScalarMulAdd(double *dst, const double *x, const double *y, int n) {
+  for (int i = 0; i < n; ++i) dst[i] += x[i] * y[i];
+}
+
+void ScalarMul(double *dst, const double *src, int n) {
+  for (int i = 0; i < n; ++i) dst[i] *= src[i];
+}
+
+bool ScalarEqual(const double *a, const double *b, int n, double epsilon) {
+  bool flag = true;
+  for (int i = 0; i < n && flag; ++i) {
+    if (std::abs(a[i] - b[i]) > epsilon) flag = false;
+  }
+  return flag;
+}
+
+void ScalarGemmMicro(int kc, const double *a, const double *b, double *c,
+                     long ldc, int rows, int cols) {
+  double acc[kGemmMR][kGemmNR] = {};
+  for (int p = 0; p < kc; ++p) {
+    for (int r = 0; r < kGemmMR; ++r) {
+      const double value = a[r];
+      for (int q = 0; q < kGemmNR; ++q) acc[r][q] += value * b[q];
+    }
+    a += kGemmMR;
+    b += kGemmNR;
+  }
+  for (int r = 0; r < rows; ++r) {
+    for (int q = 0; q < cols; ++q) c[r * ldc + q] += acc[r][q];
+  }
+}
+
+void ScalarTranspose(const double *src, int lds, double *dst, int ldd,
+                     int rows, int cols) {
+  for (int i = 0; i < rows; ++i) {
+    const double *row = src + static_cast<long>(i) * lds;
+    for (int j = 0; j < cols; ++j) {
+      dst[static_cast<long>(j) * ldd + i] = row[j];
+    }
+  }
+}
+
+// Векторные ядра транспонируют плитки size x size в регистрах, а
+// правую и нижнюю полосы за пределами первых full_rows x full_cols -
+// скалярно.
+void TransposeEdges(const double *src, int lds, double *dst, int ldd,
+                    int rows, int cols, int full_rows, int full_cols) {
+  ScalarTranspose(src + full_cols, lds,
+                  dst + static_cast<long>(full_cols) * ldd, ldd, full_rows,
+                  cols - full_cols);
+  ScalarTranspose(src + static_cast<long>(full_rows) * lds, lds,
+                  dst + full_rows, ldd, rows - full_rows, cols);
+}
+
+constexpr SimdTable kScalarTable = {
+    ScalarAdd<double>, ScalarSub<double>,  ScalarScale<double>,
+    ScalarEqual,       ScalarGemmMicro,    ScalarAdd<float>,
+    ScalarSub<float>,  ScalarScale<float>, ScalarMulAdd,
+    ScalarMul,         ScalarTranspose};
+
+#ifdef S21_SIMD_X86
+__attribute__((target("avx2,fma"))) void Avx2Add(double *dst,
+                                                 const double *src, int n) {
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d sum = _mm256_add_pd(_mm256_loadu_pd(dst + i),
+                                _mm256_loadu_pd(src + i));
+    _mm256_storeu_pd(dst + i, sum);
+  }
+  for (; i < n; ++i) dst[i] += src[i];
+}
+
+__attribute__((target("avx2,fma"))) void Avx2Sub(double *dst,
+                                                 const double *src, int n) {
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d diff = _mm256_sub_pd(_mm256_loadu_pd(dst + i),
+                                 _mm256_loadu_pd(src + i));
+    _mm256_storeu_pd(dst + i, diff);
+  }
+  for (; i < n; ++i) dst[i] -= src[i];
+}
+
+__attribute__((target("avx2,fma"))) void Avx2Scale(double *dst, double value,
+                                                   int n) {
+  const __m256d factor = _mm256_set1_pd(value);
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(dst + i, _mm256_mul_pd(_mm256_loadu_pd(dst + i), factor));
+  }
+  for (; i < n; ++i) dst[i] *= value;
+}
+
+__attribute__((target("avx2,fma"))) bool Avx2Equal(const double *a,
+                                                   const double *b, int n,
+                                                   double epsilon) {
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  const __m256d limit = _mm256_set1_pd(epsilon);
+  int i = 0;
+  bool flag = true;
+  for (; i + 4 <= n && flag; i += 4) {
+    __m256d diff =
+        _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+    __m256d over = _mm256_cmp_pd(_mm256_andnot_pd(sign, diff), limit,
+                                 _CMP_GT_OQ);
+    flag = _mm256_movemask_pd(over) == 0;
+  }
+  return flag && ScalarEqual(a + i, b + i, n - i, epsilon);
+}
+
+// строка блока 4x8 - два регистра по 4 double, всего 8 аккумуляторов
+__attribute__((target("avx2,fma"))) void Avx2GemmMicro(
+    int kc, const double *a, const double *b, double *c, long ldc, int rows,
+    int cols) {
+  __m256d acc[kGemmMR][2];
+  for (int r = 0; r < kGemmMR; ++r) {
+    acc[r][0] = _mm256_setzero_pd();
+    acc[r][1] = _mm256_setzero_pd();
+  }
+  for (int p = 0; p < kc; ++p) {
+    const __m256d b0 = _mm256_loadu_pd(b);
+    const __m256d b1 = _mm256_loadu_pd(b + 4);
+    for (int r = 0; r < kGemmMR; ++r) {
+      const __m256d value = _mm256_broadcast_sd(a + r);
+      acc[r][0] = _mm256_fmadd_pd(value, b0, acc[r][0]);
+      acc[r][1] = _mm256_fmadd_pd(value, b1, acc[r][1]);
+    }
+    a += kGemmMR;
+    b += kGemmNR;
+  }
+  if (cols == kGemmNR) {
+    for (int r = 0; r < rows; ++r) {
+      double *row = c + r * ldc;
+      _mm256_storeu_pd(row, _mm256_add_pd(_mm256_loadu_pd(row), acc[r][0]));
+      _mm256_storeu_pd(row + 4,
+                       _mm256_add_pd(_mm256_loadu_pd(row + 4), acc[r][1]));
+    }
+  } else {
+    double tile[kGemmNR];
+    for (int r = 0; r < rows; ++r) {
+      _mm256_storeu_pd(tile, acc[r][0]);
+      _mm256_storeu_pd(tile + 4, acc[r][1]);
+      for (int q = 0; q < cols; ++q) c[r * ldc + q] += tile[q];
+    }
+  }
+}
+
+__attribute__((target("avx2,fma"))) void Avx2AddFloat(float *dst,
+                                                      const float *src,
+                                                      int n) {
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 sum = _mm256_add_ps(_mm256_loadu_ps(dst + i),
+                               _mm256_loadu_ps(src + i));
+    _mm256_storeu_ps(dst + i, sum);
+  }
+  for (; i < n; ++i) dst[i] += src[i];
+}
+
+__attribute__((target("avx2,fma"))) void Avx2SubFloat(float *dst,
+                                                      const float *src,
+                                                      int n) {
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 diff = _mm256_sub_ps(_mm256_loadu_ps(dst + i),
+                                _mm256_loadu_ps(src + i));
+    _mm256_storeu_ps(dst + i, diff);
+  }
+  for (; i < n; ++i) dst[i] -= src[i];
+}
+
+__attribute__((target("avx2,fma"))) void Avx2ScaleFloat(float *dst,
+                                                        float value, int n) {
+  const __m256 factor = _mm256_set1_ps(value);
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(dst + i), factor));
+  }
+  for (; i < n; ++i) dst[i] *= value;
+}
+
+__attribute__((target("avx2,fma"))) void Avx2MulAdd(double *dst,
+                                                    const double *x,
+                                                    const double *y, int n) {
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d sum = _mm256_fmadd_pd(_mm256_loadu_pd(x + i),
+                                  _mm256_loadu_pd(y + i),
+                                  _mm256_loadu_pd(dst + i));
+    _mm256_storeu_pd(dst + i, sum);
+  }
+  for (; i < n; ++i) dst[i] += x[i] * y[i];
+}
+
+__attribute__((target("avx2,fma"))) void Avx2Mul(double *dst,
+                                                 const double *src, int n) {
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d product = _mm256_mul_pd(_mm256_loadu_pd(dst + i),
+                                    _mm256_loadu_pd(src + i));
+    _mm256_storeu_pd(dst + i, product);
+  }
+  for (; i < n; ++i) dst[i] *= src[i];
+}
+
+__attribute__((target("avx512f"))) void Avx512Add(double *dst,
+                                                  const double *src, int n) {
+  for (int i = 0; i < n; i += 8) {
+    const __mmask8 mask = n - i >= 8 ? 0xFF : (1u << (n - i)) - 1;
+    __m512d sum = _mm512_add_pd(_mm512_maskz_loadu_pd(mask, dst + i),
+                                _mm512_maskz_loadu_pd(mask, src + i));
+    _mm512_mask_storeu_pd(dst + i, mask, sum);
+  }
+}
+
+__attribute__((target("avx512f"))) void Avx512Sub(double *dst,
+                                                  const double *src, int n) {
+  for (int i = 0; i < n; i += 8) {
+    const __mmask8 mask = n - i >= 8 ? 0xFF : (1u << (n - i)) - 1;
+    __m512d diff = _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, dst + i),
+                                 _mm512_maskz_loadu_pd(mask, src + i));
+    _mm512_mask_storeu_pd(dst + i, mask, diff);
+  }
+}
+
+__attribute__((target("avx512f"))) void Avx512Scale(double *dst,
+                                                    double value, int n) {
+  const __m512d factor = _mm512_set1_pd(value);
+  for (int i = 0; i < n; i += 8) {
+    const __mmask8 mask = n - i >= 8 ? 0xFF : (1u << (n - i)) - 1;
+    __m512d product =
+        _mm512_mul_pd(_mm512_maskz_loadu_pd(mask, dst + i), factor);
+    _mm512_mask_storeu_pd(dst + i, mask, product);
+  }
+}
+
+__attribute__((target("avx512f"))) bool Avx512Equal(const double *a,
+                                                    const double *b, int n,
+                                                    double epsilon) {
+  const __m512d limit = _mm512_set1_pd(epsilon);
+  bool flag = true;
+  for (int i = 0; i < n && flag; i += 8) {
+    const __mmask8 mask = n - i >= 8 ? 0xFF : (1u << (n - i)) - 1;
+    __m512d diff = _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, a + i),
+                                 _mm512_maskz_loadu_pd(mask, b + i));
+    flag = _mm512_mask_cmp_pd_mask(mask, _mm512_abs_pd(diff), limit,
+                                   _CMP_GT_OQ) == 0;
+  }
+  return flag;
+}
+
+// строка блока 4x8 целиком помещается в один регистр
+__attribute__((target("avx512f"))) void Avx512GemmMicro(
+    int kc, const double *a, const double *b, double *c, long ldc, int rows,
+    int cols) {
+  __m512d acc[kGemmMR];
+  for (int r = 0; r < kGemmMR; ++r) acc[r] = _mm512_setzero_pd();
+  for (int p = 0; p < kc; ++p) {
+    const __m512d row_b = _mm512_loadu_pd(b);
+    for (int r = 0; r < kGemmMR; ++r) {
+      acc[r] = _mm512_fmadd_pd(_mm512_set1_pd(a[r]), row_b, acc[r]);
+    }
+    a += kGemmMR;
+    b += kGemmNR;
+  }
+  const __mmask8 mask = cols >= 8 ? 0xFF : (1u << cols) - 1;
+  for (int r = 0; r < rows; ++r) {
+    double *row = c + r * ldc;
+    __m512d sum = _mm512_add_pd(_mm512_maskz_loadu_pd(mask, row), acc[r]);
+    _mm512_mask_storeu_pd(row, mask, sum);
+  }
+}
+
+__attribute__((target("avx512f"))) void Avx512AddFloat(float *dst,
+                                                       const float *src,
+                                                       int n) {
+  for (int i = 0; i < n; i += 16) {
+    const __mmask16 mask = n - i >= 16 ? 0xFFFF : (1u << (n - i)) - 1;
+    __m512 sum = _mm512_add_ps(_mm512_maskz_loadu_ps(mask, dst + i),
+                               _mm512_maskz_loadu_ps(mask, src + i));
+    _mm512_mask_storeu_ps(dst + i, mask, sum);
+  }
+}
+
+__attribute__((target("avx512f"))) void Avx512SubFloat(float *dst,
+                                                       const float *src,
+                                                       int n) {
+  for (int i = 0; i < n; i += 16) {
+    const __mmask16 mask = n - i >= 16 ? 0xFFFF : (1u << (n - i)) - 1;
+    __m512 diff = _mm512_sub_ps(_mm512_maskz_loadu_ps(mask, dst + i),
+                                _mm512_maskz_loadu_ps(mask, src + i));
+    _mm512_mask_storeu_ps(dst + i, mask, diff);
+  }
+}
+
+__attribute__((target("avx512f"))) void Avx512ScaleFloat(float *dst,
+                                                         float value, int n) {
+  const __m512 factor = _mm512_set1_ps(value);
+  for (int i = 0; i < n; i += 16) {
+    const __mmask16 mask = n - i >= 16 ? 0xFFFF : (1u << (n - i)) - 1;
+    __m512 product =
+        _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, dst + i), factor);
+    _mm512_mask_storeu_ps(dst + i, mask, product);
+  }
+}
+
+__attribute__((target("avx512f"))) void Avx512MulAdd(double *dst,
+                                                     const double *x,
+                                                     const double *y, int n) {
+  for (int i = 0; i < n; i += 8) {
+    const __mmask8 mask = n - i >= 8 ? 0xFF : (1u << (n - i)) - 1;
+    __m512d sum = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, x + i),
+                                  _mm512_maskz_loadu_pd(mask, y + i),
+                                  _mm512_maskz_loadu_pd(mask, dst + i));
+    _mm512_mask_storeu_pd(dst + i, mask, sum);
+  }
+}
+
+__attribute__((target("avx512f"))) void Avx512Mul(double *dst,
+                                                  const double *src, int n) {
+  for (int i = 0; i < n; i += 8) {
+    const __mmask8 mask = n - i >= 8 ? 0xFF : (1u << (n - i)) - 1;
+    __m512d product = _mm512_mul_pd(_mm512_maskz_loadu_pd(mask, dst + i),
+                                    _mm512_maskz_loadu_pd(mask, src + i));
+    _mm512_mask_storeu_pd(dst + i, mask, product);
+  }
+}
+
+// 4x4: пары строк переплетаются, затем меняются половины регистров
+__attribute__((target("avx2"))) inline void Avx2TransposeTile(const double *src,
+                                                       int lds, double *dst,
+                                                       int ldd) {
+  const __m256d r0 = _mm256_loadu_pd(src);
+  const __m256d r1 = _mm256_loadu_pd(src + lds);
+  const __m256d r2 = _mm256_loadu_pd(src + 2 * lds);
+  const __m256d r3 = _mm256_loadu_pd(src + 3 * lds);
+  const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+  const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+  const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+  const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+  _mm256_storeu_pd(dst, _mm256_permute2f128_pd(t0, t2, 0x20));
+  _mm256_storeu_pd(dst + ldd, _mm256_permute2f128_pd(t1, t3, 0x20));
+  _mm256_storeu_pd(dst + 2 * ldd, _mm256_permute2f128_pd(t0, t2, 0x31));
+  _mm256_storeu_pd(dst + 3 * ldd, _mm256_permute2f128_pd(t1, t3, 0x31));
+}
+
+__attribute__((target("avx2"))) void Avx2Transpose(const double *src,
+                                                   int lds, double *dst,
+                                                   int ldd, int rows,
+                                                   int cols) {
+  const int full_rows = rows / 4 * 4, full_cols = cols / 4 * 4;
+  for (int i = 0; i < full_rows; i += 4) {
+    for (int j = 0; j < full_cols; j += 4) {
+      Avx2TransposeTile(src + static_cast<long>(i) * lds + j, lds,
+                        dst + static_cast<long>(j) * ldd + i, ldd);
+    }
+  }
+  TransposeEdges(src, lds, dst, ldd, rows, cols, full_rows, full_cols);
+}
+
+// 8x8: переплетение пар строк, затем сборка четвёрок и половин
+// перестановками из двух регистров
+__attribute__((target("avx512f"))) inline void Avx512TransposeTile(
+    const double *src, int lds, double *dst, int ldd) {
+  __m512d r[8], t[8];
+  for (int k = 0; k < 8; ++k) r[k] = _mm512_loadu_pd(src + k * lds);
+  // maskz-формы: на -O2 GCC 12 ложно предупреждает о неинициализированном
+  // _mm512_undefined_pd внутри _mm512_unpacklo_pd
+  for (int k = 0; k < 8; k += 2) {
+    t[k] = _mm512_maskz_unpacklo_pd(0xFF, r[k], r[k + 1]);
+    t[k + 1] = _mm512_maskz_unpackhi_pd(0xFF, r[k], r[k + 1]);
+  }
+  const __m512i even = _mm512_setr_epi64(0, 1, 8, 9, 4, 5, 12, 13);
+  const __m512i odd = _mm512_setr_epi64(2, 3, 10, 11, 6, 7, 14, 15);
+  // r[c] - столбцы c и c + 4 строк 0..3, r[c + 4] - те же строк 4..7
+  for (int k = 0; k < 8; k += 4) {
+    r[k] = _mm512_permutex2var_pd(t[k], even, t[k + 2]);
+    r[k + 1] = _mm512_permutex2var_pd(t[k + 1], even, t[k + 3]);
+    r[k + 2] = _mm512_permutex2var_pd(t[k], odd, t[k + 2]);
+    r[k + 3] = _mm512_permutex2var_pd(t[k + 1], odd, t[k + 3]);
+  }
+  const __m512i low = _mm512_setr_epi64(0, 1, 2, 3, 8, 9, 10, 11);
+  const __m512i high = _mm512_setr_epi64(4, 5, 6, 7, 12, 13, 14, 15);
+  for (int c = 0; c < 4; ++c) {
+    _mm512_storeu_pd(dst + c * ldd,
+                     _mm512_permutex2var_pd(r[c], low, r[c + 4]));
+    _mm512_storeu_pd(dst + (c + 4) * ldd,
+                     _mm512_permutex2var_pd(r[c], high, r[c + 4]));
+  }
+}
+
+__attribute__((target("avx512f"))) void Avx512Transpose(const double *src,
+                                                       int lds, double *dst,
+                                                       int ldd, int rows,
+                                                       int cols) {
+  const int full_rows = rows / 8 * 8, full_cols = cols / 8 * 8;
+  for (int i = 0; i < full_rows; i += 8) {
+    for (int j = 0; j < full_cols; j += 8) {
+      Avx512TransposeTile(src + static_cast<long>(i) * lds + j, lds,
+                          dst + static_cast<long>(j) * ldd + i, ldd);
+    }
+  }
+  TransposeEdges(src, lds, dst, ldd, rows, cols, full_rows, full_cols);
+}
+
+constexpr SimdTable kAvx2Table = {
+    Avx2Add,       Avx2Sub,      Avx2Scale,    Avx2Equal,
+    Avx2GemmMicro, Avx2AddFloat, Avx2SubFloat, Avx2ScaleFloat,
+    Avx2MulAdd,    Avx2Mul,      Avx2Transpose};
+constexpr SimdTable kAvx512Table = {
+    Avx512Add,       Avx512Sub,      Avx512Scale,    Avx512Equal,
+    Avx512GemmMicro, Avx512AddFloat, Avx512SubFloat, Avx512ScaleFloat,
+    Avx512MulAdd,    Avx512Mul,      Avx512Transpose};
+#endif  // S21_SIMD_X86
+
+#ifdef S21_SIMD_NEON
+void NeonAdd(double *dst, const double *src, int n) {
+  int i = 0;
+  for (; i + 2 <= n; i += 2) {
+    vst1q_f64(dst + i, vaddq_f64(vld1q_f64(dst + i), vld1q_f64(src + i)));
+  }
+  for (; i < n; ++i) dst[i] += src[i];
+}
+
+void NeonSub(double *dst, const double *src, int n) {
+  int i = 0;
+  for (; i + 2 <= n; i += 2) {
+    vst1q_f64(dst + i, vsubq_f64(vld1q_f64(dst + i), vld1q_f64(src + i)));
+  }
+  for (; i < n; ++i) dst[i] -= src[i];
+}
+
+void NeonScale(double *dst, double value, int n) {
+  int i = 0;
+  for (; i + 2 <= n; i += 2) {
+    vst1q_f64(dst + i, vmulq_n_f64(vld1q_f64(dst + i), value));
+  }
+  for (; i < n; ++i) dst[i] *= value;
+}
+
+bool NeonEqual(const double *a, const double *b, int n, double epsilon) {
+  const float64x2_t limit = vdupq_n_f64(epsilon);
+  int i = 0;
+  bool flag = true;
+  for (; i + 2 <= n && flag; i += 2) {
+    float64x2_t diff = vabsq_f64(vsubq_f64(vld1q_f64(a + i), vld1q_f64(b + i)));
+    uint64x2_t over = vcgtq_f64(diff, limit);
+    flag = (vgetq_lane_u64(over, 0) | vgetq_lane_u64(over, 1)) == 0;
+  }
+  return flag && ScalarEqual(a + i, b + i, n - i, epsilon);
+}
+
+void NeonGemmMicro(int kc, const double *a, const double *b, double *c,
+                   long ldc, int rows, int cols) {
+  float64x2_t acc[kGemmMR][4];
+  for (int r = 0; r < kGemmMR; ++r) {
+    for (int q = 0; q < 4; ++q) acc[r][q] = vdupq_n_f64(0.0);
+  }
+  for (int p = 0; p < kc; ++p) {
+    float64x2_t row_b[4];
+    for (int q = 0; q < 4; ++q) row_b[q] = vld1q_f64(b + 2 * q);
+    for (int r = 0; r < kGemmMR; ++r) {
+      for (int q = 0; q < 4; ++q) {
+        acc[r][q] = vfmaq_n_f64(acc[r][q], row_b[q], a[r]);
+      }
+    }
+    a += kGemmMR;
+    b += kGemmNR;
+  }
+  double tile[kGemmNR];
+  for (int r = 0; r < rows; ++r) {
+    for (int q = 0; q < 4; ++q) vst1q_f64(tile + 2 * q, acc[r][q]);
+    for (int q = 0; q < cols; ++q) c[r * ldc + q] += tile[q];
+  }
+}
+
+void NeonAddFloat(float *dst, const float *src, int n) {
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), vld1q_f32(src + i)));
+  }
+  for (; i < n; ++i) dst[i] += src[i];
+}
+
+void NeonSubFloat(float *dst, const float *src, int n) {
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    vst1q_f32(dst + i, vsubq_f32(vld1q_f32(dst + i), vld1q_f32(src + i)));
+  }
+  for (; i < n; ++i) dst[i] -= src[i];
+}
+
+void NeonScaleFloat(float *dst, float value, int n) {
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    vst1q_f32(dst + i, vmulq_n_f32(vld1q_f32(dst + i), value));
+  }
+  for (; i < n; ++i) dst[i] *= value;
+}
+
+void NeonMulAdd(double *dst, const double *x, const double *y, int n) {
+  int i = 0;
+  for (; i + 2 <= n; i += 2) {
+    float64x2_t sum =
+        vfmaq_f64(vld1q_f64(dst + i), vld1q_f64(x + i), vld1q_f64(y + i));
+    vst1q_f64(dst + i, sum);
+  }
+  for (; i < n; ++i) dst[i] += x[i] * y[i];
+}
+
+void NeonMul(double *dst, const double *src, int n) {
+  int i = 0;
+  for (; i + 2 <= n; i += 2) {
+    vst1q_f64(dst + i, vmulq_f64(vld1q_f64(dst + i), vld1q_f64(src + i)));
+  }
+  for (; i < n; ++i) dst[i] *= src[i];
+}
+
+// 2x2: vtrn собирает первые и вторые элементы двух строк
+inline void NeonTransposeTile(const double *src, int lds, double *dst,
+                              int ldd) {
+  const float64x2_t r0 = vld1q_f64(src);
+  const float64x2_t r1 = vld1q_f64(src + lds);
+  vst1q_f64(dst, vtrn1q_f64(r0, r1));
+  vst1q_f64(dst + ldd, vtrn2q_f64(r0, r1));
+}
+
+void NeonTranspose(const double *src, int lds, double *dst, int ldd,
+                   int rows, int cols) {
+  const int full_rows = rows / 2 * 2, full_cols = cols / 2 * 2;
+  for (int i = 0; i < full_rows; i += 2) {
+    for (int j = 0; j < full_cols; j += 2) {
+      NeonTransposeTile(src + static_cast<long>(i) * lds + j, lds,
+                        dst + static_cast<long>(j) * ldd + i, ldd);
+    }
+  }
+  TransposeEdges(src, lds, dst, ldd, rows, cols, full_rows, full_cols);
+}
+
+constexpr SimdTable kNeonTable = {
+    NeonAdd,       NeonSub,      NeonScale,    NeonEqual,
+    NeonGemmMicro, NeonAddFloat, NeonSubFloat, NeonScaleFloat,
+    NeonMulAdd,    NeonMul,      NeonTranspose};
+#endif  // S21_SIMD_NEON
+
+bool IsSupported(S21SimdLevel level) noexcept {
+  bool supported = level == S21SimdLevel::kScalar;
+#ifdef S21_SIMD_X86
+  if (level == S21SimdLevel::kAvx2) {
+    supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+  } else if (level == S21SimdLevel::kAvx512) {
+    supported = __builtin_cpu_supports("avx512f");
+  }
+#endif
+#ifdef S21_SIMD_NEON
+  if (level == S21SimdLevel::kNeon) supported = true;
+#endif
+  return supported;
+}
+
+const SimdTable *TableFor(S21SimdLevel level) noexcept {
+  const SimdTable *table = &kScalarTable;
+#ifdef S21_SIMD_X86
+  if (level == S21SimdLevel::kAvx2) table = &kAvx2Table;
+  if (level == S21SimdLevel::kAvx512) table = &kAvx512Table;
+#endif
+#ifdef S21_SIMD_NEON
+  if (level == S21SimdLevel::kNeon) table = &kNeonTable;
+#endif
+  return table;
+}
+
+struct ActiveSimd {
+  std::atomic<S21SimdLevel> level;
+  std::atomic<const SimdTable *> table;
+  ActiveSimd()
+      : level(S21DetectSimdLevel()), table(TableFor(level.load())) {}
+};
+
+ActiveSimd &Active() noexcept {
+  static ActiveSimd active;
+  return active;
+}
+}  // namespace
+
+S21SimdLevel S21DetectSimdLevel() noexcept {
+  S21SimdLevel best = S21SimdLevel::kScalar;
+  for (S21SimdLevel level : {S21SimdLevel::kNeon, S21SimdLevel::kAvx2,
+                             S21SimdLevel::kAvx512}) {
+    if (IsSupported(level)) best = level;
+  }
+  return best;
+}
+
+S21SimdLevel S21GetSimdLevel() noexcept { return Active().level.load(); }
+
+void S21SetSimdLevel(S21SimdLevel level) {
+  if (!IsSupported(level)) {
+    throw std::logic_error("S21SetSimdLevel: unsupported instruction set");
+  }
+  Active().table.store(TableFor(level));
+  Active().level.store(level);
+}
+
+namespace s21_kernels {
+
+const SimdTable &Simd() noexcept { return *Active().table.load(); }
+
+}  // namespace s21_kernels
@@ -0,0 +1,48 @@
+#ifndef S21_MATRIX_SIMD_H_
+#define S21_MATRIX_SIMD_H_
+
+// Набор инструкций для векторных ядер. Лучший доступный уровень
+// выбирается при первом обращении по CPUID, поэтому одна сборка
+// библиотеки работает и на AVX2, и на AVX-512 машинах.
+enum class S21SimdLevel { kScalar, kNeon, kAvx2, kAvx512 };
+
+S21SimdLevel S21DetectSimdLevel() noexcept;
+S21SimdLevel S21GetSimdLevel() noexcept;
+// принудительный выбор уровня (например, для сравнения путей в тестах);
+// бросает std::logic_error, если процессор уровень не поддерживает
+void S21SetSimdLevel(S21SimdLevel level);
+
+namespace s21_kernels {
+
+// размеры регистрового блока микроядра GEMM
+constexpr int kGemmMR = 4;
+constexpr int kGemmNR = 8;
+
+struct SimdTable {
+  void (*add)(double *dst, const double *src, int n);
+  void (*sub)(double *dst, const double *src, int n);
+  void (*scale)(double *dst, double value, int n);
+  // true, если все |a[i] - b[i]| <= epsilon
+  bool (*equal)(const double *a, const double *b, int n, double epsilon);
+  // C(rows x cols) += упакованная полоса A (kc x kGemmMR) *
+  // упакованная полоса B (kc x kGemmNR)
+  void (*gemm_micro)(int kc, const double *a, const double *b, double *c,
+                     long ldc, int rows, int cols);
+  // поэлементные операции для матриц одинарной точности
+  void (*add_float)(float *dst, const float *src, int n);
+  void (*sub_float)(float *dst, const float *src, int n);
+  void (*scale_float)(float *dst, float value, int n);
+  // поэлементные произведения векторов (партии матриц, s21_matrix_batch):
+  // dst[i] += x[i] * y[i] и dst[i] *= src[i]
+  void (*mul_add)(double *dst, const double *x, const double *y, int n);
+  void (*mul)(double *dst, const double *src, int n);
+  // dst(j, i) = src(i, j) для блока rows x cols (lds, ldd - шаги строк)
+  void (*transpose)(const double *src, int lds, double *dst, int ldd,
+                    int rows, int cols);
+};
+
+const SimdTable &Simd() noexcept;
+
+}  // namespace s21_kernels
+
+#endif  // S21_MATRIX_SIMD_H_
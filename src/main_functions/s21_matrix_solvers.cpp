@@ -0,0 +1,366 @@
+#include "s21_matrix_solvers.h"
+
+#include <algorithm>  // std::copy, std::fill, std::min
+#include <cmath>      // std::abs, std::sqrt, std::hypot
+#include <cstddef>    // std::size_t
+#include <stdexcept>  // logic_error
+
+#include "s21_matrix_parallel.h"
+
+namespace {
+// скалярное произведение считается по блокам фиксированной длины,
+// чтобы сумма не зависела от числа потоков
+constexpr int kDotBlock = 4096;
+
+double Dot(const std::vector<double> &a, const std::vector<double> &b) {
+  const int n = static_cast<int>(a.size());
+  const int blocks = (n + kDotBlock - 1) / kDotBlock;
+  std::vector<double> partial(blocks);
+  s21_kernels::ParallelFor(0, blocks, n, [&](int from, int to) {
+    for (int block = from; block < to; ++block) {
+      const int end = std::min(n, (block + 1) * kDotBlock);
+      double sum = 0.0;
+      for (int i = block * kDotBlock; i < end; ++i) sum += a[i] * b[i];
+      partial[block] = sum;
+    }
+  });
+  double sum = 0.0;
+  for (double value : partial) sum += value;
+  return sum;
+}
+
+double Norm(const std::vector<double> &a) { return std::sqrt(Dot(a, a)); }
+
+// y = alpha * x + beta * y
+void Axpby(double alpha, const std::vector<double> &x, double beta,
+           std::vector<double> &y) {
+  const int n = static_cast<int>(x.size());
+  s21_kernels::ParallelFor(0, n, n, [&](int from, int to) {
+    for (int i = from; i < to; ++i) y[i] = alpha * x[i] + beta * y[i];
+  });
+}
+
+void Precondition(const S21Preconditioner *preconditioner,
+                  const std::vector<double> &r, std::vector<double> &z) {
+  if (preconditioner) {
+    preconditioner->Apply(r.data(), z.data());
+  } else {
+    std::copy(r.begin(), r.end(), z.begin());
+  }
+}
+
+// r = b - A * x
+void Residual(const S21LinearOperator &a, const std::vector<double> &b,
+              const std::vector<double> &x, std::vector<double> &r) {
+  a.Apply(x.data(), r.data());
+  Axpby(1.0, b, -1.0, r);
+}
+
+// проверка размеров и норма b; нулевая правая часть решается сразу
+double Prepare(const S21LinearOperator &a, const std::vector<double> &b,
+               std::vector<double> &x, S21SolverReport &report) {
+  const std::size_t n = a.GetSize();
+  if (b.size() != n) {
+    throw std::logic_error("Solve: incorrect right-hand side size");
+  }
+  if (x.size() != n) x.assign(n, 0.0);
+  const double norm = Norm(b);
+  if (norm == 0.0) {
+    std::fill(x.begin(), x.end(), 0.0);
+    report.converged = true;
+  }
+  return norm;
+}
+
+// запись невязки итерации; true - точность достигнута
+bool Track(S21SolverReport &report, double residual, double tolerance) {
+  report.residual = residual;
+  report.history.push_back(residual);
+  report.converged = residual <= tolerance;
+  return report.converged;
+}
+
+// обратные к диагональным элементам квадратной матрицы
+template <typename Matrix>
+std::vector<double> InverseDiagonal(const Matrix &matrix) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::logic_error("S21JacobiPreconditioner: incorrect matrix size");
+  }
+  std::vector<double> inverse(matrix.GetRows());
+  for (int i = 0; i < matrix.GetRows(); ++i) {
+    if (matrix(i, i) == 0.0) {
+      throw std::logic_error("S21JacobiPreconditioner: zero on the diagonal");
+    }
+    inverse[i] = 1.0 / matrix(i, i);
+  }
+  return inverse;
+}
+}  // namespace
+
+S21DenseOperator::S21DenseOperator(const S21Matrix &matrix) : matrix_(matrix) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::logic_error("S21DenseOperator: incorrect matrix size");
+  }
+}
+
+int S21DenseOperator::GetSize() const noexcept { return matrix_.GetRows(); }
+
+void S21DenseOperator::Apply(const double *x, double *y) const {
+  const int n = matrix_.GetRows();
+  const long work = static_cast<long>(n) * n;
+  s21_kernels::ParallelFor(0, n, work, [&](int from, int to) {
+    for (int i = from; i < to; ++i) {
+      const double *row =
+          matrix_.data() + static_cast<long>(i) * matrix_.stride();
+      double sum = 0.0;
+      for (int j = 0; j < n; ++j) sum += row[j] * x[j];
+      y[i] = sum;
+    }
+  });
+}
+
+S21SparseOperator::S21SparseOperator(const S21SparseMatrix &matrix)
+    : matrix_(matrix) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::logic_error("S21SparseOperator: incorrect matrix size");
+  }
+}
+
+int S21SparseOperator::GetSize() const noexcept { return matrix_.GetRows(); }
+
+void S21SparseOperator::Apply(const double *x, double *y) const {
+  matrix_.MulVector(x, y);
+}
+
+S21JacobiPreconditioner::S21JacobiPreconditioner(const S21Matrix &matrix)
+    : inverse_diagonal_(InverseDiagonal(matrix)) {}
+
+S21JacobiPreconditioner::S21JacobiPreconditioner(
+    const S21SparseMatrix &matrix)
+    : inverse_diagonal_(InverseDiagonal(matrix)) {}
+
+void S21JacobiPreconditioner::Apply(const double *r, double *z) const {
+  const int n = static_cast<int>(inverse_diagonal_.size());
+  for (int i = 0; i < n; ++i) z[i] = r[i] * inverse_diagonal_[i];
+}
+
+S21Ilu0Preconditioner::S21Ilu0Preconditioner(const S21SparseMatrix &matrix) {
+  const S21SparseMatrix csr = matrix.Convert(S21SparseFormat::kCsr);
+  const int n = csr.GetRows();
+  if (n != csr.GetCols()) {
+    throw std::logic_error("S21Ilu0Preconditioner: incorrect matrix size");
+  }
+  // множители занимают ту же структуру, что и A
+  offsets_ = csr.Offsets();
+  indices_ = csr.Indices();
+  values_ = csr.Values();
+  diagonal_.assign(n, -1);
+  for (int i = 0; i < n; ++i) {
+    for (int p = offsets_[i]; p < offsets_[i + 1]; ++p) {
+      if (indices_[p] == i) diagonal_[i] = p;
+    }
+    if (diagonal_[i] < 0) {
+      throw std::logic_error("S21Ilu0Preconditioner: zero on the diagonal");
+    }
+  }
+  // вариант IKJ; position - места элементов строки i по столбцам
+  std::vector<int> position(n, -1);
+  for (int i = 0; i < n; ++i) {
+    for (int p = offsets_[i]; p < offsets_[i + 1]; ++p) {
+      position[indices_[p]] = p;
+    }
+    for (int p = offsets_[i]; p < diagonal_[i]; ++p) {
+      const int k = indices_[p];
+      values_[p] /= values_[diagonal_[k]];
+      for (int q = diagonal_[k] + 1; q < offsets_[k + 1]; ++q) {
+        // элементы вне структуры A отбрасываются
+        if (position[indices_[q]] >= 0) {
+          values_[position[indices_[q]]] -= values_[p] * values_[q];
+        }
+      }
+    }
+    if (values_[diagonal_[i]] == 0.0) {
+      throw std::logic_error("S21Ilu0Preconditioner: zero pivot");
+    }
+    for (int p = offsets_[i]; p < offsets_[i + 1]; ++p) {
+      position[indices_[p]] = -1;
+    }
+  }
+}
+
+void S21Ilu0Preconditioner::Apply(const double *r, double *z) const {
+  const int n = static_cast<int>(diagonal_.size());
+  // L * y = r с единичной диагональю, затем U * z = y
+  for (int i = 0; i < n; ++i) {
+    double sum = r[i];
+    for (int p = offsets_[i]; p < diagonal_[i]; ++p) {
+      sum -= values_[p] * z[indices_[p]];
+    }
+    z[i] = sum;
+  }
+  for (int i = n - 1; i >= 0; --i) {
+    double sum = z[i];
+    for (int p = diagonal_[i] + 1; p < offsets_[i + 1]; ++p) {
+      sum -= values_[p] * z[indices_[p]];
+    }
+    z[i] = sum / values_[diagonal_[i]];
+  }
+}
+
+S21SolverReport S21SolveCG(const S21LinearOperator &a,
+                           const std::vector<double> &b,
+                           std::vector<double> &x,
+                           const S21SolverOptions &options,
+                           const S21Preconditioner *preconditioner) {
+  S21SolverReport report;
+  const double norm = Prepare(a, b, x, report);
+  if (report.converged) return report;
+  const int n = a.GetSize();
+  std::vector<double> r(n), z(n), p(n), ap(n);
+  Residual(a, b, x, r);
+  report.residual = Norm(r) / norm;
+  report.converged = report.residual <= options.tolerance;
+  Precondition(preconditioner, r, z);
+  p = z;
+  double rz = Dot(r, z);
+  while (!report.converged && report.iterations < options.max_iterations) {
+    a.Apply(p.data(), ap.data());
+    const double curvature = Dot(p, ap);
+    // A не положительно определена или невязка уже нулевая
+    if (curvature <= 0.0) break;
+    const double alpha = rz / curvature;
+    Axpby(alpha, p, 1.0, x);
+    Axpby(-alpha, ap, 1.0, r);
+    ++report.iterations;
+    if (!Track(report, Norm(r) / norm, options.tolerance)) {
+      Precondition(preconditioner, r, z);
+      const double next = Dot(r, z);
+      Axpby(1.0, z, next / rz, p);
+      rz = next;
+    }
+  }
+  return report;
+}
+
+S21SolverReport S21SolveBiCGSTAB(const S21LinearOperator &a,
+                                 const std::vector<double> &b,
+                                 std::vector<double> &x,
+                                 const S21SolverOptions &options,
+                                 const S21Preconditioner *preconditioner) {
+  S21SolverReport report;
+  const double norm = Prepare(a, b, x, report);
+  if (report.converged) return report;
+  const int n = a.GetSize();
+  std::vector<double> r(n), shadow(n), p(n), v(n), s(n), t(n), p_hat(n),
+      s_hat(n);
+  Residual(a, b, x, r);
+  shadow = r;
+  report.residual = Norm(r) / norm;
+  report.converged = report.residual <= options.tolerance;
+  double rho = 1.0, alpha = 1.0, omega = 1.0;
+  while (!report.converged && report.iterations < options.max_iterations) {
+    const double next = Dot(shadow, r);
+    // обрыв метода: новое направление построить нельзя
+    if (next == 0.0 || omega == 0.0) break;
+    const double beta = next / rho * (alpha / omega);
+    // p = r + beta * (p - omega * v)
+    Axpby(-omega, v, 1.0, p);
+    Axpby(1.0, r, beta, p);
+    Precondition(preconditioner, p, p_hat);
+    a.Apply(p_hat.data(), v.data());
+    const double projection = Dot(shadow, v);
+    if (projection == 0.0) break;
+    alpha = next / projection;
+    s = r;
+    Axpby(-alpha, v, 1.0, s);
+    Axpby(alpha, p_hat, 1.0, x);
+    ++report.iterations;
+    const double half = Norm(s) / norm;
+    // s уже достаточно мало - второй полушаг не нужен
+    if (half <= options.tolerance) {
+      Track(report, half, options.tolerance);
+      break;
+    }
+    Precondition(preconditioner, s, s_hat);
+    a.Apply(s_hat.data(), t.data());
+    const double tt = Dot(t, t);
+    omega = tt == 0.0 ? 0.0 : Dot(t, s) / tt;
+    Axpby(omega, s_hat, 1.0, x);
+    r = s;
+    Axpby(-omega, t, 1.0, r);
+    Track(report, Norm(r) / norm, options.tolerance);
+    rho = next;
+  }
+  return report;
+}
+
+S21SolverReport S21SolveGMRES(const S21LinearOperator &a,
+                              const std::vector<double> &b,
+                              std::vector<double> &x,
+                              const S21SolverOptions &options,
+                              const S21Preconditioner *preconditioner) {
+  if (options.restart < 1) {
+    throw std::logic_error("S21SolveGMRES: restart must be positive");
+  }
+  S21SolverReport report;
+  const double norm = Prepare(a, b, x, report);
+  if (report.converged) return report;
+  const int n = a.GetSize(), m = options.restart;
+  // базис Крылова, Хессенберг после вращений Гивенса и правая часть
+  std::vector<std::vector<double>> basis(m + 1, std::vector<double>(n));
+  S21Matrix h(m + 1, m);
+  std::vector<double> cs(m), sn(m), g(m + 1), y(m), w(n), z(n);
+  bool stop = false;
+  while (!stop) {
+    Residual(a, b, x, basis[0]);
+    const double beta = Norm(basis[0]);
+    report.residual = beta / norm;
+    report.converged = report.residual <= options.tolerance;
+    if (report.converged || report.iterations >= options.max_iterations) break;
+    Axpby(1.0 / beta, basis[0], 0.0, basis[0]);
+    std::fill(g.begin(), g.end(), 0.0);
+    g[0] = beta;
+    int k = 0;
+    while (k < m && report.iterations < options.max_iterations && !stop) {
+      // правое предобусловливание: w = A * M^-1 * v_k
+      Precondition(preconditioner, basis[k], z);
+      a.Apply(z.data(), w.data());
+      // модифицированный процесс Грама-Шмидта
+      for (int i = 0; i <= k; ++i) {
+        h(i, k) = Dot(w, basis[i]);
+        Axpby(-h(i, k), basis[i], 1.0, w);
+      }
+      h(k + 1, k) = Norm(w);
+      const bool lucky = h(k + 1, k) == 0.0;
+      if (!lucky) Axpby(1.0 / h(k + 1, k), w, 0.0, basis[k + 1]);
+      for (int i = 0; i < k; ++i) {
+        const double upper = cs[i] * h(i, k) + sn[i] * h(i + 1, k);
+        h(i + 1, k) = -sn[i] * h(i, k) + cs[i] * h(i + 1, k);
+        h(i, k) = upper;
+      }
+      const double radius = std::hypot(h(k, k), h(k + 1, k));
+      cs[k] = h(k, k) / radius;
+      sn[k] = h(k + 1, k) / radius;
+      h(k, k) = radius;
+      h(k + 1, k) = 0.0;
+      g[k + 1] = -sn[k] * g[k];
+      g[k] = cs[k] * g[k];
+      ++k;
+      ++report.iterations;
+      // |g[k]| - норма невязки без явного вычисления x
+      stop = Track(report, std::abs(g[k]) / norm, options.tolerance) || lucky;
+    }
+    // x += M^-1 * V * y, где H * y = g
+    for (int i = k - 1; i >= 0; --i) {
+      double sum = g[i];
+      for (int j = i + 1; j < k; ++j) sum -= h(i, j) * y[j];
+      y[i] = sum / h(i, i);
+    }
+    std::fill(w.begin(), w.end(), 0.0);
+    for (int i = 0; i < k; ++i) Axpby(y[i], basis[i], 1.0, w);
+    Precondition(preconditioner, w, z);
+    Axpby(1.0, z, 1.0, x);
+    if (report.iterations >= options.max_iterations) stop = true;
+  }
+  return report;
+}
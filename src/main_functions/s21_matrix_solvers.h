@@ -0,0 +1,108 @@
+#ifndef S21_MATRIX_SOLVERS_H_
+#define S21_MATRIX_SOLVERS_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_matrix_sparse.h"
+
+// Квадратная матрица, заданная только произведением на вектор:
+// итерационным методам больше ничего не нужно, поэтому матрицу можно
+// не хранить целиком.
+class S21LinearOperator {
+ public:
+  virtual ~S21LinearOperator() = default;
+  virtual int GetSize() const noexcept = 0;
+  // y = A * x, оба вектора длины GetSize()
+  virtual void Apply(const double *x, double *y) const = 0;
+};
+
+// операторы над готовыми матрицами; матрица должна пережить оператор
+class S21DenseOperator : public S21LinearOperator {
+ private:
+  const S21Matrix &matrix_;
+
+ public:
+  explicit S21DenseOperator(const S21Matrix &matrix);
+  int GetSize() const noexcept override;
+  void Apply(const double *x, double *y) const override;
+};
+
+class S21SparseOperator : public S21LinearOperator {
+ private:
+  const S21SparseMatrix &matrix_;
+
+ public:
+  explicit S21SparseOperator(const S21SparseMatrix &matrix);
+  int GetSize() const noexcept override;
+  void Apply(const double *x, double *y) const override;
+};
+
+// z = M^-1 * r, где M - приближение к A, обращаемое дёшево
+class S21Preconditioner {
+ public:
+  virtual ~S21Preconditioner() = default;
+  virtual void Apply(const double *r, double *z) const = 0;
+};
+
+// M = diag(A)
+class S21JacobiPreconditioner : public S21Preconditioner {
+ private:
+  std::vector<double> inverse_diagonal_;
+
+ public:
+  explicit S21JacobiPreconditioner(const S21Matrix &matrix);
+  explicit S21JacobiPreconditioner(const S21SparseMatrix &matrix);
+  void Apply(const double *r, double *z) const override;
+};
+
+// неполное LU без заполнения: множители L и U занимают только
+// позиции ненулевых элементов A
+class S21Ilu0Preconditioner : public S21Preconditioner {
+ private:
+  // L (без единичной диагонали) и U в структуре CSR матрицы A,
+  // diagonal_ - позиции диагональных элементов
+  std::vector<int> offsets_, indices_, diagonal_;
+  std::vector<double> values_;
+
+ public:
+  explicit S21Ilu0Preconditioner(const S21SparseMatrix &matrix);
+  void Apply(const double *r, double *z) const override;
+};
+
+struct S21SolverOptions {
+  // остановка при ||b - A * x|| <= tolerance * ||b||
+  double tolerance = 1e-10;
+  int max_iterations = 1000;
+  // число векторов Крылова между перезапусками GMRES
+  int restart = 30;
+};
+
+struct S21SolverReport {
+  bool converged = false;
+  int iterations = 0;
+  // относительная невязка в конце и после каждой итерации
+  double residual = 0.0;
+  std::vector<double> history;
+};
+
+// Решение A * x = b; x - начальное приближение (при несовпадении
+// размера - нулевое), в нём же возвращается ответ. Память - несколько
+// векторов длины n (для GMRES - restart + 1). CG - только для
+// симметричных положительно определённых A, GMRES и BiCGSTAB - для
+// любых невырожденных.
+S21SolverReport S21SolveCG(const S21LinearOperator &a,
+                           const std::vector<double> &b,
+                           std::vector<double> &x,
+                           const S21SolverOptions &options = {},
+                           const S21Preconditioner *preconditioner = nullptr);
+S21SolverReport S21SolveGMRES(
+    const S21LinearOperator &a, const std::vector<double> &b,
+    std::vector<double> &x, const S21SolverOptions &options = {},
+    const S21Preconditioner *preconditioner = nullptr);
+S21SolverReport S21SolveBiCGSTAB(
+    const S21LinearOperator &a, const std::vector<double> &b,
+    std::vector<double> &x, const S21SolverOptions &options = {},
+    const S21Preconditioner *preconditioner = nullptr);
+
+#endif  // S21_MATRIX_SOLVERS_H_
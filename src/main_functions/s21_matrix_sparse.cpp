@@ -0,0 +1,432 @@
+#include "s21_matrix_sparse.h"
+
+#include <algorithm>  // std::sort, std::lower_bound, std::max
+#include <cmath>      // std::abs
+#include <numeric>    // std::partial_sum
+#include <stdexcept>  // logic_error, out_of_range
+#include <utility>    // std::pair
+
+#include "s21_matrix_parallel.h"
+
+namespace {
+void CheckSameSize(const S21SparseMatrix &a, const S21SparseMatrix &b,
+                   const char *message) {
+  if (a.GetRows() != b.GetRows() || a.GetCols() != b.GetCols()) {
+    throw std::logic_error(message);
+  }
+}
+
+// other в формате format; копия делается только при смене формата
+const S21SparseMatrix &InFormat(const S21SparseMatrix &other,
+                                S21SparseFormat format,
+                                S21SparseMatrix &storage) {
+  if (other.GetFormat() == format) return other;
+  storage = other.Convert(format);
+  return storage;
+}
+
+// Произведение по Густавсону для матриц в CSR (a - m x k, b - k x n):
+// сначала по строкам считается число элементов результата, затем
+// строки заполняются через плотный накопитель длины n. Строки
+// независимы, поэтому оба прохода делятся между потоками.
+void Gustavson(int m, int n, const std::vector<int> &a_offsets,
+               const std::vector<int> &a_indices,
+               const std::vector<double> &a_values,
+               const std::vector<int> &b_offsets,
+               const std::vector<int> &b_indices,
+               const std::vector<double> &b_values, std::vector<int> &offsets,
+               std::vector<int> &indices, std::vector<double> &values) {
+  const int k = static_cast<int>(b_offsets.size()) - 1;
+  const long work = static_cast<long>(a_indices.size()) *
+                    (b_indices.size() / std::max(k, 1) + 1);
+  offsets.assign(m + 1, 0);
+  s21_kernels::ParallelFor(0, m, work, [&](int from, int to) {
+    std::vector<int> mark(n, -1);
+    for (int i = from; i < to; ++i) {
+      int count = 0;
+      for (int p = a_offsets[i]; p < a_offsets[i + 1]; ++p) {
+        const int row = a_indices[p];
+        for (int q = b_offsets[row]; q < b_offsets[row + 1]; ++q) {
+          if (mark[b_indices[q]] != i) {
+            mark[b_indices[q]] = i;
+            ++count;
+          }
+        }
+      }
+      offsets[i + 1] = count;
+    }
+  });
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  indices.resize(offsets[m]);
+  values.resize(offsets[m]);
+  s21_kernels::ParallelFor(0, m, work, [&](int from, int to) {
+    std::vector<int> mark(n, -1);
+    std::vector<double> accumulator(n);
+    for (int i = from; i < to; ++i) {
+      int end = offsets[i];
+      for (int p = a_offsets[i]; p < a_offsets[i + 1]; ++p) {
+        const int row = a_indices[p];
+        const double value = a_values[p];
+        for (int q = b_offsets[row]; q < b_offsets[row + 1]; ++q) {
+          const int col = b_indices[q];
+          if (mark[col] != i) {
+            mark[col] = i;
+            accumulator[col] = 0.0;
+            indices[end++] = col;
+          }
+          accumulator[col] += value * b_values[q];
+        }
+      }
+      std::sort(indices.begin() + offsets[i], indices.begin() + end);
+      for (int p = offsets[i]; p < end; ++p) {
+        values[p] = accumulator[indices[p]];
+      }
+    }
+  });
+}
+}  // namespace
+
+S21SparseMatrix::S21SparseMatrix() : S21SparseMatrix(0, 0) {}
+
+S21SparseMatrix::S21SparseMatrix(int rows, int cols, S21SparseFormat format)
+    : rows_(rows), cols_(cols), format_(format) {
+  if (rows < 0 || cols < 0) {
+    throw std::length_error("S21SparseMatrix: negative matrix size");
+  }
+  offsets_.assign(Major() + 1, 0);
+}
+
+S21SparseMatrix::S21SparseMatrix(const S21Matrix &dense,
+                                 S21SparseFormat format)
+    : S21SparseMatrix(dense.GetRows(), dense.GetCols(), format) {
+  const bool csr = format_ == S21SparseFormat::kCsr;
+  for (int major = 0; major < Major(); ++major) {
+    for (int minor = 0; minor < Minor(); ++minor) {
+      const double value = csr ? dense(major, minor) : dense(minor, major);
+      if (value != 0.0) {
+        indices_.push_back(minor);
+        values_.push_back(value);
+      }
+    }
+    offsets_[major + 1] = static_cast<int>(indices_.size());
+  }
+}
+
+S21SparseMatrix S21SparseMatrix::FromTriplets(
+    int rows, int cols, const std::vector<S21Triplet> &triplets,
+    S21SparseFormat format) {
+  S21SparseMatrix result(rows, cols, format);
+  const bool csr = format == S21SparseFormat::kCsr;
+  // раскладка по линиям подсчётом, затем сортировка внутри линии
+  std::vector<int> count(result.Major() + 1, 0);
+  for (const S21Triplet &triplet : triplets) {
+    if (triplet.row < 0 || triplet.row >= rows || triplet.col < 0 ||
+        triplet.col >= cols) {
+      throw std::out_of_range("FromTriplets: index out of range");
+    }
+    ++count[(csr ? triplet.row : triplet.col) + 1];
+  }
+  std::partial_sum(count.begin(), count.end(), count.begin());
+  std::vector<std::pair<int, double>> entries(triplets.size());
+  std::vector<int> next(count.begin(), count.end() - 1);
+  for (const S21Triplet &triplet : triplets) {
+    const int major = csr ? triplet.row : triplet.col;
+    entries[next[major]++] = {csr ? triplet.col : triplet.row, triplet.value};
+  }
+  for (int major = 0; major < result.Major(); ++major) {
+    auto begin = entries.begin() + count[major];
+    auto end = entries.begin() + count[major + 1];
+    std::sort(begin, end, [](const auto &a, const auto &b) {
+      return a.first < b.first;
+    });
+    for (auto it = begin; it != end;) {
+      const int minor = it->first;
+      double sum = 0.0;
+      for (; it != end && it->first == minor; ++it) sum += it->second;
+      if (sum != 0.0) {
+        result.indices_.push_back(minor);
+        result.values_.push_back(sum);
+      }
+    }
+    result.offsets_[major + 1] = static_cast<int>(result.indices_.size());
+  }
+  return result;
+}
+
+int S21SparseMatrix::Major() const noexcept {
+  return format_ == S21SparseFormat::kCsr ? rows_ : cols_;
+}
+
+int S21SparseMatrix::Minor() const noexcept {
+  return format_ == S21SparseFormat::kCsr ? cols_ : rows_;
+}
+
+int S21SparseMatrix::GetRows() const noexcept { return rows_; }
+
+int S21SparseMatrix::GetCols() const noexcept { return cols_; }
+
+S21SparseFormat S21SparseMatrix::GetFormat() const noexcept { return format_; }
+
+int S21SparseMatrix::NonZeros() const noexcept {
+  return static_cast<int>(values_.size());
+}
+
+const std::vector<int> &S21SparseMatrix::Offsets() const noexcept {
+  return offsets_;
+}
+
+const std::vector<int> &S21SparseMatrix::Indices() const noexcept {
+  return indices_;
+}
+
+const std::vector<double> &S21SparseMatrix::Values() const noexcept {
+  return values_;
+}
+
+S21SparseMatrix S21SparseMatrix::Convert(S21SparseFormat format) const {
+  if (format == format_) return *this;
+  // смена формата - сортировка подсчётом по второму индексу, линии
+  // обходятся по порядку, поэтому индексы в новых линиях возрастают
+  S21SparseMatrix result(rows_, cols_, format);
+  for (int index : indices_) ++result.offsets_[index + 1];
+  std::partial_sum(result.offsets_.begin(), result.offsets_.end(),
+                   result.offsets_.begin());
+  result.indices_.resize(indices_.size());
+  result.values_.resize(values_.size());
+  std::vector<int> next(result.offsets_.begin(), result.offsets_.end() - 1);
+  for (int major = 0; major < Major(); ++major) {
+    for (int p = offsets_[major]; p < offsets_[major + 1]; ++p) {
+      const int position = next[indices_[p]]++;
+      result.indices_[position] = major;
+      result.values_[position] = values_[p];
+    }
+  }
+  return result;
+}
+
+S21Matrix S21SparseMatrix::ToDense() const {
+  S21Matrix result(rows_, cols_);
+  const bool csr = format_ == S21SparseFormat::kCsr;
+  for (int major = 0; major < Major(); ++major) {
+    for (int p = offsets_[major]; p < offsets_[major + 1]; ++p) {
+      if (csr) {
+        result(major, indices_[p]) = values_[p];
+      } else {
+        result(indices_[p], major) = values_[p];
+      }
+    }
+  }
+  return result;
+}
+
+double S21SparseMatrix::operator()(int row, int col) const {
+  if (row < 0 || col < 0 || row >= rows_ || col >= cols_) {
+    throw std::out_of_range("Index out of range");
+  }
+  const bool csr = format_ == S21SparseFormat::kCsr;
+  const int major = csr ? row : col, minor = csr ? col : row;
+  auto begin = indices_.begin() + offsets_[major];
+  auto end = indices_.begin() + offsets_[major + 1];
+  auto it = std::lower_bound(begin, end, minor);
+  return it != end && *it == minor ? values_[it - indices_.begin()] : 0.0;
+}
+
+bool S21SparseMatrix::EqMatrix(const S21SparseMatrix &other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) return false;
+  S21SparseMatrix storage;
+  const S21SparseMatrix &same = InFormat(other, format_, storage);
+  // слияние линий: элемент без пары сравнивается с нулём
+  bool flag = true;
+  for (int major = 0; major < Major() && flag; ++major) {
+    int p = offsets_[major], q = same.offsets_[major];
+    const int p_end = offsets_[major + 1], q_end = same.offsets_[major + 1];
+    while ((p < p_end || q < q_end) && flag) {
+      double difference = 0.0;
+      if (q == q_end || (p < p_end && indices_[p] < same.indices_[q])) {
+        difference = values_[p++];
+      } else if (p == p_end || same.indices_[q] < indices_[p]) {
+        difference = same.values_[q++];
+      } else {
+        difference = values_[p++] - same.values_[q++];
+      }
+      flag = std::abs(difference) <= EPSILON;
+    }
+  }
+  return flag;
+}
+
+bool S21SparseMatrix::EqMatrix(const S21Matrix &other) const {
+  if (rows_ != other.GetRows() || cols_ != other.GetCols()) return false;
+  const bool csr = format_ == S21SparseFormat::kCsr;
+  bool flag = true;
+  for (int major = 0; major < Major() && flag; ++major) {
+    int p = offsets_[major];
+    for (int minor = 0; minor < Minor() && flag; ++minor) {
+      double value = 0.0;
+      if (p < offsets_[major + 1] && indices_[p] == minor) value = values_[p++];
+      const double dense = csr ? other(major, minor) : other(minor, major);
+      flag = std::abs(value - dense) <= EPSILON;
+    }
+  }
+  return flag;
+}
+
+S21SparseMatrix S21SparseMatrix::Merge(const S21SparseMatrix &other,
+                                       double sign) const {
+  S21SparseMatrix storage;
+  const S21SparseMatrix &same = InFormat(other, format_, storage);
+  S21SparseMatrix result(rows_, cols_, format_);
+  result.indices_.reserve(indices_.size() + same.indices_.size());
+  result.values_.reserve(values_.size() + same.values_.size());
+  for (int major = 0; major < Major(); ++major) {
+    int p = offsets_[major], q = same.offsets_[major];
+    const int p_end = offsets_[major + 1], q_end = same.offsets_[major + 1];
+    while (p < p_end || q < q_end) {
+      int minor = 0;
+      double value = 0.0;
+      if (q == q_end || (p < p_end && indices_[p] < same.indices_[q])) {
+        minor = indices_[p];
+        value = values_[p++];
+      } else if (p == p_end || same.indices_[q] < indices_[p]) {
+        minor = same.indices_[q];
+        value = sign * same.values_[q++];
+      } else {
+        minor = indices_[p];
+        value = values_[p++] + sign * same.values_[q++];
+      }
+      // взаимно уничтожившиеся элементы не хранятся
+      if (value != 0.0) {
+        result.indices_.push_back(minor);
+        result.values_.push_back(value);
+      }
+    }
+    result.offsets_[major + 1] = static_cast<int>(result.indices_.size());
+  }
+  return result;
+}
+
+void S21SparseMatrix::SumMatrix(const S21SparseMatrix &other) {
+  CheckSameSize(*this, other, "SumMatrix: Incorrect matrix size");
+  *this = Merge(other, 1.0);
+}
+
+void S21SparseMatrix::SubMatrix(const S21SparseMatrix &other) {
+  CheckSameSize(*this, other, "SubMatrix: Incorrect matrix size");
+  *this = Merge(other, -1.0);
+}
+
+void S21SparseMatrix::MulNumber(const double num) {
+  for (double &value : values_) value *= num;
+}
+
+S21SparseMatrix S21SparseMatrix::Transpose() const {
+  // массивы формата CSR для A - это массивы CSC для A^T, и наоборот
+  S21SparseMatrix transposed(*this);
+  transposed.rows_ = cols_;
+  transposed.cols_ = rows_;
+  transposed.format_ = format_ == S21SparseFormat::kCsr
+                           ? S21SparseFormat::kCsc
+                           : S21SparseFormat::kCsr;
+  return transposed.Convert(format_);
+}
+
+void S21SparseMatrix::MulVector(const double *x, double *y) const {
+  if (format_ == S21SparseFormat::kCsr) {
+    s21_kernels::ParallelFor(0, rows_, NonZeros(), [&](int from, int to) {
+      for (int i = from; i < to; ++i) {
+        double sum = 0.0;
+        for (int p = offsets_[i]; p < offsets_[i + 1]; ++p) {
+          sum += values_[p] * x[indices_[p]];
+        }
+        y[i] = sum;
+      }
+    });
+  } else {
+    // столбцы пишут в общие элементы y, поэтому последовательно
+    std::fill(y, y + rows_, 0.0);
+    for (int j = 0; j < cols_; ++j) {
+      for (int p = offsets_[j]; p < offsets_[j + 1]; ++p) {
+        y[indices_[p]] += values_[p] * x[j];
+      }
+    }
+  }
+}
+
+S21SparseMatrix S21SparseMatrix::operator+(const S21SparseMatrix &other) const {
+  CheckSameSize(*this, other, "SumMatrix: Incorrect matrix size");
+  return Merge(other, 1.0);
+}
+
+S21SparseMatrix S21SparseMatrix::operator-(const S21SparseMatrix &other) const {
+  CheckSameSize(*this, other, "SubMatrix: Incorrect matrix size");
+  return Merge(other, -1.0);
+}
+
+S21SparseMatrix S21SparseMatrix::operator*(const S21SparseMatrix &other) const {
+  if (cols_ != other.rows_) {
+    throw std::logic_error("MulMatrix: incorrect matrix size");
+  }
+  S21SparseMatrix storage;
+  const S21SparseMatrix &same = InFormat(other, format_, storage);
+  S21SparseMatrix result(rows_, other.cols_, format_);
+  if (format_ == S21SparseFormat::kCsr) {
+    Gustavson(rows_, other.cols_, offsets_, indices_, values_, same.offsets_,
+              same.indices_, same.values_, result.offsets_, result.indices_,
+              result.values_);
+  } else {
+    // CSC для C = A * B - это CSR для C^T = B^T * A^T
+    Gustavson(other.cols_, rows_, same.offsets_, same.indices_, same.values_,
+              offsets_, indices_, values_, result.offsets_, result.indices_,
+              result.values_);
+  }
+  return result;
+}
+
+S21Matrix S21SparseMatrix::operator*(const S21Matrix &dense) const {
+  if (cols_ != dense.GetRows()) {
+    throw std::logic_error("MulMatrix: incorrect matrix size");
+  }
+  S21SparseMatrix storage;
+  const S21SparseMatrix &csr = InFormat(*this, S21SparseFormat::kCsr, storage);
+  const int n = dense.GetCols();
+  S21Matrix result(rows_, n);
+  // строка i результата - сумма строк dense с весами из строки i
+  const long work = static_cast<long>(NonZeros()) * n;
+  s21_kernels::ParallelFor(0, rows_, work, [&](int from, int to) {
+    for (int i = from; i < to; ++i) {
+      double *row = result.data() + static_cast<long>(i) * result.stride();
+      for (int p = csr.offsets_[i]; p < csr.offsets_[i + 1]; ++p) {
+        const double value = csr.values_[p];
+        const double *source =
+            dense.data() + static_cast<long>(csr.indices_[p]) * dense.stride();
+        for (int j = 0; j < n; ++j) row[j] += value * source[j];
+      }
+    }
+  });
+  return result;
+}
+
+S21SparseMatrix S21SparseMatrix::operator*(const double number) const {
+  S21SparseMatrix result(*this);
+  result.MulNumber(number);
+  return result;
+}
+
+bool S21SparseMatrix::operator==(const S21SparseMatrix &other) const {
+  return EqMatrix(other);
+}
+
+S21SparseMatrix &S21SparseMatrix::operator+=(const S21SparseMatrix &other) {
+  SumMatrix(other);
+  return *this;
+}
+
+S21SparseMatrix &S21SparseMatrix::operator-=(const S21SparseMatrix &other) {
+  SubMatrix(other);
+  return *this;
+}
+
+S21SparseMatrix &S21SparseMatrix::operator*=(const double number) {
+  MulNumber(number);
+  return *this;
+}
@@ -0,0 +1,86 @@
+#ifndef S21_MATRIX_SPARSE_H_
+#define S21_MATRIX_SPARSE_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// способ сжатия: по строкам (CSR) или по столбцам (CSC)
+enum class S21SparseFormat { kCsr, kCsc };
+
+// элемент для сборки разреженной матрицы
+struct S21Triplet {
+  int row;
+  int col;
+  double value;
+};
+
+// Разреженная матрица: хранятся только ненулевые элементы, память
+// и время операций пропорциональны их числу. Линия (строка для CSR,
+// столбец для CSC) major занимает [Offsets()[major],
+// Offsets()[major + 1]) в Indices()/Values(), индексы внутри линии
+// возрастают. Операции с матрицей другого формата сначала переводят её
+// в формат *this.
+class S21SparseMatrix {
+ private:
+  int rows_, cols_;
+  S21SparseFormat format_;
+  std::vector<int> offsets_;
+  std::vector<int> indices_;
+  std::vector<double> values_;
+  static constexpr double EPSILON = 1e-7;
+  // число линий и длина линии
+  int Major() const noexcept;
+  int Minor() const noexcept;
+  // *this + sign * other
+  S21SparseMatrix Merge(const S21SparseMatrix &other, double sign) const;
+
+ public:
+  S21SparseMatrix();
+  // нулевая матрица
+  S21SparseMatrix(int rows, int cols,
+                  S21SparseFormat format = S21SparseFormat::kCsr);
+  // ненулевые элементы плотной матрицы
+  explicit S21SparseMatrix(const S21Matrix &dense,
+                           S21SparseFormat format = S21SparseFormat::kCsr);
+  // повторяющиеся позиции складываются, нули отбрасываются
+  static S21SparseMatrix FromTriplets(
+      int rows, int cols, const std::vector<S21Triplet> &triplets,
+      S21SparseFormat format = S21SparseFormat::kCsr);
+
+  int GetRows() const noexcept;
+  int GetCols() const noexcept;
+  S21SparseFormat GetFormat() const noexcept;
+  int NonZeros() const noexcept;
+  const std::vector<int> &Offsets() const noexcept;
+  const std::vector<int> &Indices() const noexcept;
+  const std::vector<double> &Values() const noexcept;
+
+  S21SparseMatrix Convert(S21SparseFormat format) const;
+  S21Matrix ToDense() const;
+
+  // отсутствующий элемент - 0
+  double operator()(int row, int col) const;
+  // сравнение с допуском; отсутствующие элементы считаются нулями
+  bool EqMatrix(const S21SparseMatrix &other) const;
+  bool EqMatrix(const S21Matrix &other) const;
+  void SumMatrix(const S21SparseMatrix &other);
+  void SubMatrix(const S21SparseMatrix &other);
+  void MulNumber(const double num);
+  // в том же формате, что и *this
+  S21SparseMatrix Transpose() const;
+  // y = A * x; x - GetCols() элементов, y - GetRows()
+  void MulVector(const double *x, double *y) const;
+
+  S21SparseMatrix operator+(const S21SparseMatrix &other) const;
+  S21SparseMatrix operator-(const S21SparseMatrix &other) const;
+  S21SparseMatrix operator*(const S21SparseMatrix &other) const;
+  S21Matrix operator*(const S21Matrix &dense) const;
+  S21SparseMatrix operator*(const double number) const;
+  bool operator==(const S21SparseMatrix &other) const;
+  S21SparseMatrix &operator+=(const S21SparseMatrix &other);
+  S21SparseMatrix &operator-=(const S21SparseMatrix &other);
+  S21SparseMatrix &operator*=(const double number);
+};
+
+#endif  // S21_MATRIX_SPARSE_H_
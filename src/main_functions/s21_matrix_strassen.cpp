@@ -0,0 +1,37 @@
+#include "s21_matrix_strassen.h"
+
+#include <cstddef>    // std::size_t
+#include <stdexcept>  // logic_error
+#include <vector>     // std::pmr::vector
+
+#include "s21_matrix_kernels.h"
+
+namespace {
+// ядро читает операнды построчно; прочие виды копируются в copy
+S21ConstMatrixView RowMajor(S21ConstMatrixView view, S21Matrix &copy) {
+  if (view.ColStride() == 1) return view;
+  copy = S21Matrix(view);
+  return copy.View();
+}
+}  // namespace
+
+S21Matrix S21MulStrassen(S21ConstMatrixView lhs, S21ConstMatrixView rhs,
+                         int cutoff) {
+  if (lhs.GetCols() != rhs.GetRows()) {
+    throw std::logic_error("MulStrassen: incorrect matrix size");
+  }
+  if (cutoff < 1) {
+    throw std::logic_error("MulStrassen: cutoff must be positive");
+  }
+  const int m = lhs.GetRows(), n = rhs.GetCols(), k = lhs.GetCols();
+  S21Matrix lhs_copy, rhs_copy, result(m, n);
+  const S21ConstMatrixView a = RowMajor(lhs, lhs_copy);
+  const S21ConstMatrixView b = RowMajor(rhs, rhs_copy);
+  std::pmr::vector<double> workspace(
+      static_cast<std::size_t>(s21_kernels::StrassenWorkspace(m, n, k, cutoff)),
+      S21GetMemoryResource());
+  s21_kernels::StrassenGemm(m, n, k, a.data(), a.RowStride(), b.data(),
+                            b.RowStride(), result.data(), result.stride(),
+                            cutoff, workspace.data());
+  return result;
+}
@@ -0,0 +1,18 @@
+#ifndef S21_MATRIX_STRASSEN_H_
+#define S21_MATRIX_STRASSEN_H_
+
+#include "s21_matrix_oop.h"
+
+// размер, ниже которого блоки умножаются обычным ядром
+constexpr int kS21StrassenCutoff = 512;
+
+// Произведение методом Штрассена-Винограда для больших матриц (только
+// double): O(n^2.81) умножений вместо O(n^3). Размеры могут быть любыми,
+// в том числе нечётными и неквадратными. Все временные блоки рекурсии
+// берутся из одного буфера, выделенного на вызов. Погрешность растёт
+// с глубиной рекурсии быстрее, чем у MulMatrix, поэтому cutoff
+// не стоит делать малым без нужды.
+S21Matrix S21MulStrassen(S21ConstMatrixView lhs, S21ConstMatrixView rhs,
+                         int cutoff = kS21StrassenCutoff);
+
+#endif  // S21_MATRIX_STRASSEN_H_
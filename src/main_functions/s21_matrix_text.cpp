@@ -0,0 +1,243 @@
+#include "s21_matrix_text.h"
+
+#include <algorithm>  // std::min
+#include <charconv>   // std::from_chars, std::to_chars
+#include <climits>    // INT_MAX
+#include <cstdio>     // std::FILE
+#include <cstring>    // std::memchr
+#include <stdexcept>  // invalid_argument, logic_error, runtime_error
+#include <vector>
+
+#include "s21_matrix_parallel.h"
+
+namespace {
+// примерный размер куска текста на один разбор
+constexpr std::size_t kChunkBytes = std::size_t(1) << 20;
+// строк матрицы на кусок при записи
+constexpr int kFormatRows = 64;
+// хватает на 17 значащих цифр, знак и порядок
+constexpr int kNumberChars = 32;
+
+bool IsBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+bool IsEmptyLine(const char *begin, const char *end) {
+  while (begin < end && IsBlank(*begin)) ++begin;
+  return begin == end;
+}
+
+// вызывает line(begin, end) для каждой строки [begin, end) без '\n'
+template <typename Line>
+void ForEachLine(const char *begin, const char *end, Line line) {
+  while (begin < end) {
+    const auto *newline =
+        static_cast<const char *>(std::memchr(begin, '\n', end - begin));
+    const char *stop = newline ? newline : end;
+    line(begin, stop);
+    begin = newline ? newline + 1 : end;
+  }
+}
+
+[[noreturn]] void Fail(long line, const std::string &message) {
+  throw std::invalid_argument("ReadText: line " + std::to_string(line) +
+                              ": " + message);
+}
+
+// Значения строки по порядку; пишутся в row, пока их не больше limit.
+// Возвращает число значений в строке.
+int ParseLine(const char *p, const char *end, char delimiter, double *row,
+              int limit, long line) {
+  const bool blanks = delimiter == ' ';
+  int count = 0;
+  while (true) {
+    while (p < end && IsBlank(*p)) ++p;
+    if (p == end && (blanks || count == 0)) break;
+    // from_chars не принимает явный плюс
+    if (p < end && *p == '+') ++p;
+    double value = 0.0;
+    const auto [next, error] = std::from_chars(p, end, value);
+    if (error != std::errc()) Fail(line, "invalid number");
+    if (row && count < limit) row[count] = value;
+    ++count;
+    p = next;
+    while (p < end && IsBlank(*p)) ++p;
+    if (p == end) break;
+    if (!blanks) {
+      if (*p != delimiter) Fail(line, "unexpected character");
+      ++p;
+    }
+  }
+  return count;
+}
+
+char Detect(const char *begin, const char *end) {
+  for (char candidate : {',', ';'}) {
+    if (std::memchr(begin, candidate, end - begin)) return candidate;
+  }
+  return ' ';
+}
+
+// строки [from, to) матрицы в тексте, каждая со своим '\n'
+std::string FormatRows(const S21Matrix &matrix, int from, int to,
+                       char delimiter, int precision) {
+  std::string text;
+  text.reserve(static_cast<std::size_t>(to - from) *
+               (matrix.GetCols() * 8 + 1));
+  char number[kNumberChars];
+  for (int i = from; i < to; ++i) {
+    const double *row =
+        matrix.data() + static_cast<long>(i) * matrix.stride();
+    for (int j = 0; j < matrix.GetCols(); ++j) {
+      if (j > 0) text.push_back(delimiter);
+      const auto result =
+          precision == 0
+              ? std::to_chars(number, number + kNumberChars, row[j])
+              : std::to_chars(number, number + kNumberChars, row[j],
+                              std::chars_format::general, precision);
+      text.append(number, result.ptr);
+    }
+    text.push_back('\n');
+  }
+  return text;
+}
+
+// куски текста по kFormatRows строк, отформатированные параллельно
+std::vector<std::string> FormatBlocks(const S21Matrix &matrix,
+                                      const S21TextOptions &options) {
+  if (options.precision < 0 || options.precision > 17) {
+    throw std::logic_error("WriteText: precision must be in [0, 17]");
+  }
+  const char delimiter = options.delimiter ? options.delimiter : ',';
+  const int rows = matrix.GetRows();
+  std::vector<std::string> blocks((rows + kFormatRows - 1) / kFormatRows);
+  const long work = static_cast<long>(rows) * matrix.GetCols() * 64;
+  s21_kernels::ParallelFor(
+      0, static_cast<int>(blocks.size()), work, [&](int from, int to) {
+        for (int block = from; block < to; ++block) {
+          const int first = block * kFormatRows;
+          blocks[block] =
+              FormatRows(matrix, first, std::min(rows, first + kFormatRows),
+                         delimiter, options.precision);
+        }
+      });
+  return blocks;
+}
+}  // namespace
+
+S21Matrix S21ParseText(std::string_view text, const S21TextOptions &options) {
+  const char *data = text.data();
+  const std::size_t size = text.size();
+  // куски начинаются с начала строки
+  std::vector<std::size_t> bounds{0};
+  while (bounds.back() < size) {
+    std::size_t next = bounds.back() + kChunkBytes;
+    if (next < size) {
+      const auto *newline = static_cast<const char *>(
+          std::memchr(data + next, '\n', size - next));
+      next = newline ? newline - data + 1 : size;
+    }
+    bounds.push_back(std::min(next, size));
+  }
+  const int chunks = static_cast<int>(bounds.size()) - 1;
+  // первый проход: строк текста и строк с данными в каждом куске
+  std::vector<long> lines(chunks + 1), rows(chunks + 1);
+  const long work = static_cast<long>(size);
+  s21_kernels::ParallelFor(0, chunks, work, [&](int from, int to) {
+    for (int c = from; c < to; ++c) {
+      ForEachLine(data + bounds[c], data + bounds[c + 1],
+                  [&](const char *begin, const char *end) {
+                    ++lines[c + 1];
+                    if (!IsEmptyLine(begin, end)) ++rows[c + 1];
+                  });
+    }
+  });
+  for (int c = 0; c < chunks; ++c) {
+    lines[c + 1] += lines[c];
+    rows[c + 1] += rows[c];
+  }
+  if (rows[chunks] > INT_MAX) {
+    throw std::length_error("ReadText: too many rows");
+  }
+  if (rows[chunks] == 0) return S21Matrix();
+  // число столбцов и разделитель - по первой строке с данными
+  const char *first = data;
+  const char *first_end = data;
+  long first_line = 0;
+  for (;; first = first_end + 1) {
+    const auto *newline = static_cast<const char *>(
+        std::memchr(first, '\n', data + size - first));
+    first_end = newline ? newline : data + size;
+    ++first_line;
+    if (!IsEmptyLine(first, first_end)) break;
+  }
+  const char delimiter =
+      options.delimiter ? options.delimiter : Detect(first, first_end);
+  const int cols =
+      ParseLine(first, first_end, delimiter, nullptr, 0, first_line);
+  S21Matrix result(static_cast<int>(rows[chunks]), cols);
+  // второй проход: значения сразу в строки матрицы
+  s21_kernels::ParallelFor(0, chunks, work, [&](int from, int to) {
+    for (int c = from; c < to; ++c) {
+      long line = lines[c], row = rows[c];
+      ForEachLine(data + bounds[c], data + bounds[c + 1],
+                  [&](const char *begin, const char *end) {
+                    ++line;
+                    if (IsEmptyLine(begin, end)) return;
+                    double *target = result.data() + row * result.stride();
+                    const int count =
+                        ParseLine(begin, end, delimiter, target, cols, line);
+                    if (count != cols) {
+                      Fail(line, std::to_string(count) +
+                                     " values, expected " +
+                                     std::to_string(cols));
+                    }
+                    ++row;
+                  });
+    }
+  });
+  return result;
+}
+
+S21Matrix S21ReadText(const std::string &path, const S21TextOptions &options) {
+  std::FILE *file = std::fopen(path.c_str(), "rb");
+  if (!file) {
+    throw std::runtime_error("ReadText: can not open " + path);
+  }
+  std::string text;
+  char buffer[1 << 16];
+  std::size_t read = 0;
+  while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    text.append(buffer, read);
+  }
+  const bool failed = std::ferror(file) != 0;
+  std::fclose(file);
+  if (failed) {
+    throw std::runtime_error("ReadText: can not read " + path);
+  }
+  return S21ParseText(text, options);
+}
+
+std::string S21FormatText(const S21Matrix &matrix,
+                          const S21TextOptions &options) {
+  std::string text;
+  for (const std::string &block : FormatBlocks(matrix, options)) {
+    text += block;
+  }
+  return text;
+}
+
+void S21WriteText(const std::string &path, const S21Matrix &matrix,
+                  const S21TextOptions &options) {
+  const std::vector<std::string> blocks = FormatBlocks(matrix, options);
+  std::FILE *file = std::fopen(path.c_str(), "wb");
+  if (!file) {
+    throw std::runtime_error("WriteText: can not open " + path);
+  }
+  bool failed = false;
+  for (const std::string &block : blocks) {
+    failed = failed ||
+             std::fwrite(block.data(), 1, block.size(), file) != block.size();
+  }
+  if (std::fclose(file) != 0 || failed) {
+    throw std::runtime_error("WriteText: can not write " + path);
+  }
+}
@@ -0,0 +1,37 @@
+#ifndef S21_MATRIX_TEXT_H_
+#define S21_MATRIX_TEXT_H_
+
+#include <string>
+#include <string_view>
+
+#include "s21_matrix_oop.h"
+
+struct S21TextOptions {
+  // Разделитель значений в строке; ' ' - любые пробелы и табуляции.
+  // При чтении 0 - определить по первой строке данных (',' или ';',
+  // если они в ней есть, иначе пробелы), при записи 0 - ','.
+  char delimiter = 0;
+  // значащих цифр при записи (1..17); 0 - кратчайшая запись, которая
+  // читается обратно в то же число
+  int precision = 0;
+};
+
+// Матрица из текста: строка текста - строка матрицы, пустые строки
+// пропускаются, размер берётся из данных. Числа разбираются
+// std::from_chars прямо в буфер матрицы, большой текст делится
+// по переводам строк на куски, которые разбираются параллельно.
+// Нечисло или строка другой длины - std::invalid_argument с номером
+// строки, ошибка чтения файла - std::runtime_error.
+S21Matrix S21ParseText(std::string_view text,
+                       const S21TextOptions &options = {});
+S21Matrix S21ReadText(const std::string &path,
+                      const S21TextOptions &options = {});
+
+// запись по строкам через std::to_chars; строки форматируются
+// параллельно
+std::string S21FormatText(const S21Matrix &matrix,
+                          const S21TextOptions &options = {});
+void S21WriteText(const std::string &path, const S21Matrix &matrix,
+                  const S21TextOptions &options = {});
+
+#endif  // S21_MATRIX_TEXT_H_
@@ -0,0 +1,430 @@
+#include "s21_matrix_tiled.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>  // std::min, std::max, std::copy
+#include <climits>    // INT_MAX
+#include <cstdint>    // std::int64_t
+#include <cstring>    // std::memcmp, std::memcpy
+#include <stdexcept>  // logic_error, runtime_error, out_of_range
+#include <utility>    // std::move, std::exchange
+
+#include "s21_matrix_kernels.h"
+#include "s21_matrix_simd.h"
+
+namespace {
+constexpr char kMagic[8] = {'S', '2', '1', 'T', 'I', 'L', 'E', 'D'};
+// фоновых чтений одновременно
+constexpr std::size_t kMaxPending = 4;
+
+// заголовок файла; плитки идут за ним по строкам плиток
+struct Header {
+  char magic[8];
+  std::int64_t rows;
+  std::int64_t cols;
+  std::int64_t tile;
+  char reserved[32];
+};
+static_assert(sizeof(Header) == 64, "header must stay 64 bytes");
+
+void ReadAll(int fd, void *data, std::size_t bytes, off_t offset) {
+  auto *out = static_cast<char *>(data);
+  while (bytes > 0) {
+    const ssize_t done = ::pread(fd, out, bytes, offset);
+    if (done <= 0) throw std::runtime_error("TiledMatrix: read failed");
+    out += done;
+    bytes -= done;
+    offset += done;
+  }
+}
+
+void WriteAll(int fd, const void *data, std::size_t bytes, off_t offset) {
+  const auto *in = static_cast<const char *>(data);
+  while (bytes > 0) {
+    const ssize_t done = ::pwrite(fd, in, bytes, offset);
+    if (done <= 0) throw std::runtime_error("TiledMatrix: write failed");
+    in += done;
+    bytes -= done;
+    offset += done;
+  }
+}
+
+int Blocks(int size, int tile) { return (size + tile - 1) / tile; }
+
+// новый файл из нулевых плиток (дыры в файле, место не занимается)
+int CreateFile(const std::string &path, int rows, int cols, int tile) {
+  if (rows < 0 || cols < 0) {
+    throw std::length_error("TiledMatrix: negative matrix size");
+  }
+  if (tile < 1) {
+    throw std::logic_error("TiledMatrix: tile must be positive");
+  }
+  const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    throw std::runtime_error("TiledMatrix: can not create " + path);
+  }
+  Header header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.rows = rows;
+  header.cols = cols;
+  header.tile = tile;
+  const off_t tiles =
+      static_cast<off_t>(Blocks(rows, tile)) * Blocks(cols, tile);
+  const off_t size = sizeof(Header) + tiles * tile * tile * sizeof(double);
+  try {
+    WriteAll(fd, &header, sizeof(header), 0);
+    if (::ftruncate(fd, size) != 0) {
+      throw std::runtime_error("TiledMatrix: can not resize " + path);
+    }
+  } catch (...) {
+    ::close(fd);
+    throw;
+  }
+  return fd;
+}
+
+// обход плиток в порядке файла; (next_row, next_col) - следующая
+// плитка, её стоит начать читать до работы с текущей
+template <typename Body>
+void ForEachTile(int tile_rows, int tile_cols, Body body) {
+  const int count = tile_rows * tile_cols;
+  for (int index = 0; index < count; ++index) {
+    const int next = std::min(index + 1, count - 1);
+    body(index / tile_cols, index % tile_cols, next / tile_cols,
+         next % tile_cols);
+  }
+}
+}  // namespace
+
+S21TiledMatrix::S21TiledMatrix(int fd, int rows, int cols,
+                               const S21TileOptions &options)
+    : fd_(fd),
+      rows_(rows),
+      cols_(cols),
+      options_(options),
+      tile_rows_(Blocks(rows, options.tile)),
+      tile_cols_(Blocks(cols, options.tile)),
+      capacity_(std::max<std::size_t>(
+          2, options.cache_bytes / (sizeof(double) * options.tile *
+                                    options.tile))) {}
+
+S21TiledMatrix::S21TiledMatrix(const std::string &path, int rows, int cols,
+                               const S21TileOptions &options)
+    : S21TiledMatrix(CreateFile(path, rows, cols, options.tile), rows, cols,
+                     options) {}
+
+S21TiledMatrix S21TiledMatrix::Open(const std::string &path,
+                                    const S21TileOptions &options) {
+  const int fd = ::open(path.c_str(), O_RDWR);
+  if (fd < 0) {
+    throw std::runtime_error("TiledMatrix: can not open " + path);
+  }
+  Header header;
+  try {
+    ReadAll(fd, &header, sizeof(header), 0);
+  } catch (const std::runtime_error &) {
+    // короткий файл - такая же ошибка формата, как и чужой
+    header = Header{};
+  }
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.tile < 1 || header.tile > INT_MAX || header.rows < 0 ||
+      header.cols < 0 || header.rows > INT_MAX || header.cols > INT_MAX) {
+    ::close(fd);
+    throw std::runtime_error("TiledMatrix: " + path +
+                             " is not a tiled matrix file");
+  }
+  S21TileOptions opened = options;
+  opened.tile = static_cast<int>(header.tile);
+  return S21TiledMatrix(fd, static_cast<int>(header.rows),
+                        static_cast<int>(header.cols), opened);
+}
+
+S21TiledMatrix::S21TiledMatrix(S21TiledMatrix &&other) noexcept
+    : fd_(std::exchange(other.fd_, -1)),
+      rows_(other.rows_),
+      cols_(other.cols_),
+      options_(other.options_),
+      tile_rows_(other.tile_rows_),
+      tile_cols_(other.tile_cols_),
+      capacity_(other.capacity_),
+      cache_(std::move(other.cache_)),
+      order_(std::move(other.order_)),
+      pending_(std::move(other.pending_)),
+      stats_(other.stats_) {}
+
+S21TiledMatrix::~S21TiledMatrix() {
+  if (fd_ < 0) return;
+  // фоновые чтения пишут в свои буферы, дожидаемся их до закрытия файла
+  pending_.clear();
+  try {
+    Flush();
+  } catch (const std::runtime_error &) {
+    // из деструктора не бросаем; Flush() можно вызвать явно
+  }
+  ::close(fd_);
+}
+
+int S21TiledMatrix::GetRows() const noexcept { return rows_; }
+
+int S21TiledMatrix::GetCols() const noexcept { return cols_; }
+
+int S21TiledMatrix::GetTile() const noexcept { return options_.tile; }
+
+int S21TiledMatrix::TileRows() const noexcept { return tile_rows_; }
+
+int S21TiledMatrix::TileCols() const noexcept { return tile_cols_; }
+
+S21TileStats S21TiledMatrix::Stats() const noexcept { return stats_; }
+
+long S21TiledMatrix::TileSize() const noexcept {
+  return static_cast<long>(options_.tile) * options_.tile;
+}
+
+int S21TiledMatrix::Height(int tile_row) const noexcept {
+  return std::min(options_.tile, rows_ - tile_row * options_.tile);
+}
+
+int S21TiledMatrix::Width(int tile_col) const noexcept {
+  return std::min(options_.tile, cols_ - tile_col * options_.tile);
+}
+
+void S21TiledMatrix::WriteBack(int index, const Entry &entry) const {
+  const std::size_t bytes = sizeof(double) * TileSize();
+  WriteAll(fd_, entry.data.data(), bytes,
+           sizeof(Header) + static_cast<off_t>(index) * bytes);
+  ++stats_.writes;
+}
+
+void S21TiledMatrix::Evict() const {
+  const int index = order_.back();
+  auto found = cache_.find(index);
+  if (found->second.dirty) WriteBack(index, found->second);
+  order_.pop_back();
+  cache_.erase(found);
+}
+
+S21TiledMatrix::Entry &S21TiledMatrix::Fetch(int tile_row,
+                                             int tile_col) const {
+  if (tile_row < 0 || tile_col < 0 || tile_row >= tile_rows_ ||
+      tile_col >= tile_cols_) {
+    throw std::out_of_range("TiledMatrix: tile index out of range");
+  }
+  const int index = tile_row * tile_cols_ + tile_col;
+  auto found = cache_.find(index);
+  if (found != cache_.end()) {
+    ++stats_.hits;
+    order_.splice(order_.begin(), order_, found->second.position);
+    return found->second;
+  }
+  ++stats_.misses;
+  std::vector<double> data;
+  auto waiting = pending_.find(index);
+  if (waiting != pending_.end()) {
+    std::future<std::vector<double>> read = std::move(waiting->second);
+    pending_.erase(waiting);
+    data = read.get();
+    ++stats_.prefetched;
+  } else {
+    const std::size_t bytes = sizeof(double) * TileSize();
+    data.resize(TileSize());
+    ReadAll(fd_, data.data(), bytes,
+            sizeof(Header) + static_cast<off_t>(index) * bytes);
+  }
+  while (cache_.size() >= capacity_) Evict();
+  order_.push_front(index);
+  Entry &entry = cache_[index];
+  entry.data = std::move(data);
+  entry.dirty = false;
+  entry.position = order_.begin();
+  return entry;
+}
+
+const double *S21TiledMatrix::ReadTile(int tile_row, int tile_col) const {
+  return Fetch(tile_row, tile_col).data.data();
+}
+
+double *S21TiledMatrix::WriteTile(int tile_row, int tile_col) {
+  Entry &entry = Fetch(tile_row, tile_col);
+  entry.dirty = true;
+  return entry.data.data();
+}
+
+void S21TiledMatrix::Prefetch(int tile_row, int tile_col) const {
+  if (!options_.prefetch || tile_row < 0 || tile_col < 0 ||
+      tile_row >= tile_rows_ || tile_col >= tile_cols_) {
+    return;
+  }
+  const int index = tile_row * tile_cols_ + tile_col;
+  if (cache_.count(index) || pending_.count(index) ||
+      pending_.size() >= kMaxPending) {
+    return;
+  }
+  // плитки нет в кэше, значит в файле её актуальная версия
+  const int fd = fd_;
+  const std::size_t size = TileSize();
+  const off_t offset =
+      sizeof(Header) + static_cast<off_t>(index) * size * sizeof(double);
+  pending_.emplace(index, std::async(std::launch::async, [fd, size, offset] {
+                     std::vector<double> data(size);
+                     ReadAll(fd, data.data(), size * sizeof(double), offset);
+                     return data;
+                   }));
+}
+
+void S21TiledMatrix::Flush() {
+  for (auto &[index, entry] : cache_) {
+    if (entry.dirty) {
+      WriteBack(index, entry);
+      entry.dirty = false;
+    }
+  }
+}
+
+double S21TiledMatrix::operator()(int row, int col) const {
+  if (row < 0 || col < 0 || row >= rows_ || col >= cols_) {
+    throw std::out_of_range("Index out of range");
+  }
+  const int tile = options_.tile;
+  return ReadTile(row / tile, col / tile)[row % tile * tile + col % tile];
+}
+
+void S21TiledMatrix::Set(int row, int col, double value) {
+  if (row < 0 || col < 0 || row >= rows_ || col >= cols_) {
+    throw std::out_of_range("Index out of range");
+  }
+  const int tile = options_.tile;
+  WriteTile(row / tile, col / tile)[row % tile * tile + col % tile] = value;
+}
+
+S21Matrix S21TiledMatrix::Load(int row, int col, int rows, int cols) const {
+  if (row < 0 || col < 0 || rows < 0 || cols < 0 || row > rows_ - rows ||
+      col > cols_ - cols) {
+    throw std::out_of_range("Load: index out of range");
+  }
+  const int tile = options_.tile;
+  S21Matrix result(rows, cols);
+  for (int i = row; i < row + rows;) {
+    const int height = std::min(row + rows, (i / tile + 1) * tile) - i;
+    for (int j = col; j < col + cols;) {
+      const int width = std::min(col + cols, (j / tile + 1) * tile) - j;
+      const double *source = ReadTile(i / tile, j / tile);
+      for (int r = 0; r < height; ++r) {
+        const double *line = source + (i % tile + r) * tile + j % tile;
+        std::copy(line, line + width, &result(i - row + r, j - col));
+      }
+      j += width;
+    }
+    i += height;
+  }
+  return result;
+}
+
+void S21TiledMatrix::Store(const S21Matrix &block, int row, int col) {
+  const int rows = block.GetRows(), cols = block.GetCols();
+  if (row < 0 || col < 0 || row > rows_ - rows || col > cols_ - cols) {
+    throw std::out_of_range("Store: index out of range");
+  }
+  const int tile = options_.tile;
+  for (int i = row; i < row + rows;) {
+    const int height = std::min(row + rows, (i / tile + 1) * tile) - i;
+    for (int j = col; j < col + cols;) {
+      const int width = std::min(col + cols, (j / tile + 1) * tile) - j;
+      double *target = WriteTile(i / tile, j / tile);
+      for (int r = 0; r < height; ++r) {
+        const double *line = &block(i - row + r, j - col);
+        std::copy(line, line + width,
+                  target + (i % tile + r) * tile + j % tile);
+      }
+      j += width;
+    }
+    i += height;
+  }
+}
+
+S21Matrix S21TiledMatrix::ToDense() const { return Load(0, 0, rows_, cols_); }
+
+void S21TiledMatrix::CheckSameShape(const S21TiledMatrix &other,
+                                    const char *message) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_ ||
+      options_.tile != other.options_.tile) {
+    throw std::logic_error(message);
+  }
+}
+
+void S21TiledMatrix::SumMatrix(const S21TiledMatrix &other) {
+  CheckSameShape(other, "SumMatrix: incorrect matrix size");
+  const auto add = s21_kernels::Simd().add;
+  const int size = static_cast<int>(TileSize());
+  ForEachTile(tile_rows_, tile_cols_, [&](int i, int j, int ni, int nj) {
+    Prefetch(ni, nj);
+    other.Prefetch(ni, nj);
+    const double *source = other.ReadTile(i, j);
+    add(WriteTile(i, j), source, size);
+  });
+}
+
+void S21TiledMatrix::SubMatrix(const S21TiledMatrix &other) {
+  CheckSameShape(other, "SubMatrix: incorrect matrix size");
+  const auto sub = s21_kernels::Simd().sub;
+  const int size = static_cast<int>(TileSize());
+  ForEachTile(tile_rows_, tile_cols_, [&](int i, int j, int ni, int nj) {
+    Prefetch(ni, nj);
+    other.Prefetch(ni, nj);
+    const double *source = other.ReadTile(i, j);
+    sub(WriteTile(i, j), source, size);
+  });
+}
+
+void S21TiledMatrix::MulNumber(const double num) {
+  const auto scale = s21_kernels::Simd().scale;
+  const int size = static_cast<int>(TileSize());
+  ForEachTile(tile_rows_, tile_cols_, [&](int i, int j, int ni, int nj) {
+    Prefetch(ni, nj);
+    scale(WriteTile(i, j), num, size);
+  });
+}
+
+S21TiledMatrix S21TiledMatrix::Transpose(const std::string &path) const {
+  S21TiledMatrix result(path, cols_, rows_, options_);
+  const int tile = options_.tile;
+  ForEachTile(result.tile_rows_, result.tile_cols_,
+              [&](int i, int j, int ni, int nj) {
+                Prefetch(nj, ni);
+                const double *source = ReadTile(j, i);
+                double *target = result.WriteTile(i, j);
+                for (int r = 0; r < tile; ++r) {
+                  for (int c = 0; c < tile; ++c) {
+                    target[r * tile + c] = source[c * tile + r];
+                  }
+                }
+              });
+  return result;
+}
+
+S21TiledMatrix S21TiledMatrix::MulMatrix(const S21TiledMatrix &other,
+                                         const std::string &path) const {
+  if (cols_ != other.rows_ || options_.tile != other.options_.tile) {
+    throw std::logic_error("MulMatrix: incorrect matrix size");
+  }
+  S21TiledMatrix result(path, rows_, other.cols_, options_);
+  const int tile = options_.tile;
+  // плитка C накапливается в кэше, пока через память идут строка плиток
+  // A и столбец плиток B; Gemm - по настоящим размерам плиток, чтобы
+  // дополнение крайних плиток не участвовало в сумме
+  ForEachTile(result.tile_rows_, result.tile_cols_,
+              [&](int i, int j, int ni, int nj) {
+                double *target = result.WriteTile(i, j);
+                for (int k = 0; k < tile_cols_; ++k) {
+                  // следующая пара - дальше по k или для следующей плитки C
+                  const bool last = k + 1 == tile_cols_;
+                  Prefetch(last ? ni : i, last ? 0 : k + 1);
+                  other.Prefetch(last ? 0 : k + 1, last ? nj : j);
+                  const double *lhs = ReadTile(i, k);
+                  const double *rhs = other.ReadTile(k, j);
+                  s21_kernels::Gemm(Height(i), other.Width(j), Width(k), lhs,
+                                    tile, 1, rhs, tile, 1, target, tile);
+                }
+              });
+  return result;
+}
@@ -0,0 +1,113 @@
+#ifndef S21_MATRIX_TILED_H_
+#define S21_MATRIX_TILED_H_
+
+#include <cstddef>
+#include <future>
+#include <list>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+struct S21TileOptions {
+  // сторона квадратной плитки
+  int tile = 256;
+  // память под кэш плиток одной матрицы; меньше двух плиток не бывает
+  std::size_t cache_bytes = std::size_t(256) << 20;
+  // чтение следующей плитки в фоне, пока считается текущая
+  bool prefetch = true;
+};
+
+// счётчики кэша плиток
+struct S21TileStats {
+  long hits = 0;
+  long misses = 0;
+  // промахи, закрытые фоновым чтением
+  long prefetched = 0;
+  long writes = 0;
+};
+
+// Матрица больше оперативной памяти (только double): элементы лежат
+// в файле плитками tile x tile (крайние плитки дополнены нулями),
+// в памяти держится LRU-кэш плиток в пределах cache_bytes. Изменённые
+// плитки записываются при вытеснении и в Flush(). Операции проходят
+// матрицу плитка за плиткой и заранее читают следующую, поэтому диск
+// и вычисления работают одновременно. Указатели, возвращаемые
+// ReadTile/WriteTile, действительны до следующего обращения к кэшу
+// этой матрицы.
+class S21TiledMatrix {
+ private:
+  struct Entry {
+    std::vector<double> data;
+    bool dirty;
+    std::list<int>::iterator position;
+  };
+  int fd_;
+  int rows_, cols_;
+  S21TileOptions options_;
+  int tile_rows_, tile_cols_;
+  std::size_t capacity_;
+  // кэш не меняет значения элементов, поэтому доступен и из const
+  mutable std::unordered_map<int, Entry> cache_;
+  // от недавно использованных к давним
+  mutable std::list<int> order_;
+  mutable std::map<int, std::future<std::vector<double>>> pending_;
+  mutable S21TileStats stats_;
+
+  S21TiledMatrix(int fd, int rows, int cols, const S21TileOptions &options);
+  long TileSize() const noexcept;
+  Entry &Fetch(int tile_row, int tile_col) const;
+  void Evict() const;
+  void WriteBack(int index, const Entry &entry) const;
+  // строк и столбцов с данными в плитке
+  int Height(int tile_row) const noexcept;
+  int Width(int tile_col) const noexcept;
+  void CheckSameShape(const S21TiledMatrix &other, const char *message) const;
+
+ public:
+  // новая нулевая матрица в файле path (файл перезаписывается)
+  S21TiledMatrix(const std::string &path, int rows, int cols,
+                 const S21TileOptions &options = {});
+  // ранее записанная матрица; tile из options игнорируется
+  static S21TiledMatrix Open(const std::string &path,
+                             const S21TileOptions &options = {});
+  S21TiledMatrix(const S21TiledMatrix &) = delete;
+  S21TiledMatrix(S21TiledMatrix &&other) noexcept;
+  S21TiledMatrix &operator=(const S21TiledMatrix &) = delete;
+  S21TiledMatrix &operator=(S21TiledMatrix &&) = delete;
+  // записывает изменённые плитки
+  ~S21TiledMatrix();
+
+  int GetRows() const noexcept;
+  int GetCols() const noexcept;
+  int GetTile() const noexcept;
+  int TileRows() const noexcept;
+  int TileCols() const noexcept;
+  S21TileStats Stats() const noexcept;
+
+  // плитка (tile_row, tile_col): tile x tile элементов по строкам
+  const double *ReadTile(int tile_row, int tile_col) const;
+  double *WriteTile(int tile_row, int tile_col);
+  // начать фоновое чтение плитки, если её нет в кэше
+  void Prefetch(int tile_row, int tile_col) const;
+  void Flush();
+
+  double operator()(int row, int col) const;
+  void Set(int row, int col, double value);
+  // обмен с плотными блоками, например для загрузки по частям
+  S21Matrix Load(int row, int col, int rows, int cols) const;
+  void Store(const S21Matrix &block, int row, int col);
+  S21Matrix ToDense() const;
+
+  void SumMatrix(const S21TiledMatrix &other);
+  void SubMatrix(const S21TiledMatrix &other);
+  void MulNumber(const double num);
+  // результаты - новые матрицы в файле path с теми же параметрами
+  S21TiledMatrix Transpose(const std::string &path) const;
+  S21TiledMatrix MulMatrix(const S21TiledMatrix &other,
+                           const std::string &path) const;
+};
+
+#endif  // S21_MATRIX_TILED_H_
@@ -0,0 +1,30 @@
+#include "s21_matrix_view.h"
+
+#include <stdexcept>  // logic_error
+
+#include "s21_matrix_kernels.h"
+#include "s21_matrix_oop.h"
+
+void S21MulAdd(S21ConstMatrixView a, S21ConstMatrixView b, S21MatrixView c,
+               double alpha) {
+  const int m = a.GetRows(), n = b.GetCols(), k = a.GetCols();
+  if (b.GetRows() != k || c.GetRows() != m || c.GetCols() != n) {
+    throw std::logic_error("MulMatrix: incorrect matrix size");
+  }
+  if (c.ColStride() == 1 || n == 1) {
+    s21_kernels::Gemm(m, n, k, a.data(), a.RowStride(), a.ColStride(),
+                      b.data(), b.RowStride(), b.ColStride(), c.data(),
+                      c.RowStride(), alpha);
+  } else if (c.RowStride() == 1 || m == 1) {
+    // приёмник лежит по столбцам: считаем C^T += alpha * B^T * A^T
+    s21_kernels::Gemm(n, m, k, b.data(), b.ColStride(), b.RowStride(),
+                      a.data(), a.ColStride(), a.RowStride(), c.data(),
+                      c.ColStride(), alpha);
+  } else {
+    S21Matrix product(m, n);
+    s21_kernels::Gemm(m, n, k, a.data(), a.RowStride(), a.ColStride(),
+                      b.data(), b.RowStride(), b.ColStride(), product.data(),
+                      product.stride(), alpha);
+    c += product;
+  }
+}
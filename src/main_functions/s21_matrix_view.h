@@ -0,0 +1,185 @@
+#ifndef S21_MATRIX_VIEW_H_
+#define S21_MATRIX_VIEW_H_
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+#include "s21_matrix_expr.h"
+#include "s21_matrix_parallel.h"
+
+// Невладеющий вид на чужой буфер: элемент (i, j) лежит по адресу
+// data[i * row_stride + j * col_stride]. Так без копирования задаются
+// блок, строка, столбец и транспонированная матрица, в том числе поверх
+// внешнего буфера. Вид не продлевает жизнь буфера.
+// Вид - лист ленивых выражений. Присваивание виду записывает элементы
+// в буфер, а не перенацеливает вид; источник не должен частично
+// перекрываться с приёмником-видом. S21Matrix, в буфер которой смотрит
+// вид из выражения, вычисляет его через временную матрицу.
+template <typename T>
+class S21BasicMatrixView : public S21MatrixExpr<S21BasicMatrixView<T>> {
+ private:
+  T *data_;
+  int rows_, cols_;
+  int row_stride_, col_stride_;
+  // поэлементно: this(i, j) = op(this(i, j), expr(i, j))
+  template <typename E, typename Op>
+  void Evaluate(const E &expr, Op op);
+
+ public:
+  using value_type = std::remove_const_t<T>;
+
+  S21BasicMatrixView(T *data, int rows, int cols, int row_stride,
+                     int col_stride = 1);
+  S21BasicMatrixView(const S21BasicMatrixView &other) = default;
+  // вид на изменяемые данные приводится к виду только для чтения
+  template <typename U, typename = std::enable_if_t<
+                            std::is_same<T, const U>::value>>
+  S21BasicMatrixView(const S21BasicMatrixView<U> &other) noexcept
+      : S21BasicMatrixView(other.data(), other.GetRows(), other.GetCols(),
+                           other.RowStride(), other.ColStride()) {}
+
+  int GetRows() const noexcept { return rows_; }
+  int GetCols() const noexcept { return cols_; }
+  T *data() const noexcept { return data_; }
+  int RowStride() const noexcept { return row_stride_; }
+  int ColStride() const noexcept { return col_stride_; }
+  T &operator()(int row, int col) const noexcept {
+    return data_[static_cast<long>(row) * row_stride_ +
+                 static_cast<long>(col) * col_stride_];
+  }
+
+  S21BasicMatrixView Block(int row, int col, int rows, int cols) const;
+  S21BasicMatrixView Row(int row) const { return Block(row, 0, 1, cols_); }
+  S21BasicMatrixView Col(int col) const { return Block(0, col, rows_, 1); }
+  S21BasicMatrixView Transposed() const noexcept {
+    return {data_, cols_, rows_, col_stride_, row_stride_};
+  }
+  // пересекаются ли элементы вида с памятью [begin, end)
+  bool Aliases(const void *begin, const void *end) const noexcept;
+
+  // копирование элементов other в буфер вида
+  S21BasicMatrixView &operator=(const S21BasicMatrixView &other);
+  template <typename E>
+  S21BasicMatrixView &operator=(const S21MatrixExpr<E> &expr);
+  template <typename E>
+  S21BasicMatrixView &operator+=(const S21MatrixExpr<E> &expr);
+  template <typename E>
+  S21BasicMatrixView &operator-=(const S21MatrixExpr<E> &expr);
+  S21BasicMatrixView &operator*=(value_type number);
+};
+
+using S21MatrixView = S21BasicMatrixView<double>;
+using S21ConstMatrixView = S21BasicMatrixView<const double>;
+
+namespace s21_expr {
+template <typename T>
+constexpr bool kIsView = false;
+template <typename T>
+constexpr bool kIsView<S21BasicMatrixView<T>> = true;
+}  // namespace s21_expr
+
+// C += alpha * A * B ядром умножения матриц (только double). Шаги видов
+// передаются ядру как есть, поэтому блоки и транспонированные операнды
+// не копируются
+void S21MulAdd(S21ConstMatrixView a, S21ConstMatrixView b, S21MatrixView c,
+               double alpha = 1.0);
+
+template <typename T>
+S21BasicMatrixView<T>::S21BasicMatrixView(T *data, int rows, int cols,
+                                          int row_stride, int col_stride)
+    : data_(data),
+      rows_(rows),
+      cols_(cols),
+      row_stride_(row_stride),
+      col_stride_(col_stride) {
+  if (rows < 0 || cols < 0) {
+    throw std::length_error("S21MatrixView: negative matrix size");
+  }
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrixView<T>::Block(int row, int col,
+                                                   int rows, int cols) const {
+  if (row < 0 || col < 0 || rows < 0 || cols < 0 || row > rows_ - rows ||
+      col > cols_ - cols) {
+    throw std::out_of_range("Block: index out of range");
+  }
+  return {&(*this)(row, col), rows, cols, row_stride_, col_stride_};
+}
+
+template <typename T>
+bool S21BasicMatrixView<T>::Aliases(const void *begin,
+                                    const void *end) const noexcept {
+  bool flag = false;
+  if (rows_ > 0 && cols_ > 0) {
+    const long last_row = static_cast<long>(rows_ - 1) * row_stride_;
+    const long last_col = static_cast<long>(cols_ - 1) * col_stride_;
+    const T *first =
+        data_ + std::min(last_row, 0L) + std::min(last_col, 0L);
+    const T *last =
+        data_ + std::max(last_row, 0L) + std::max(last_col, 0L) + 1;
+    const std::less<const void *> less;
+    flag = less(first, end) && less(begin, last);
+  }
+  return flag;
+}
+
+template <typename T>
+template <typename E, typename Op>
+void S21BasicMatrixView<T>::Evaluate(const E &expr, Op op) {
+  static_assert(!std::is_const<T>::value, "S21ConstMatrixView is read-only");
+  const long work = static_cast<long>(rows_) * cols_;
+  s21_kernels::ParallelFor(0, rows_, work, [&](int from, int to) {
+    for (int i = from; i < to; ++i) {
+      for (int j = 0; j < cols_; ++j) {
+        T &cell = (*this)(i, j);
+        cell = op(cell, expr(i, j));
+      }
+    }
+  });
+}
+
+template <typename T>
+S21BasicMatrixView<T> &S21BasicMatrixView<T>::operator=(
+    const S21BasicMatrixView &other) {
+  return *this = static_cast<const S21MatrixExpr<S21BasicMatrixView> &>(other);
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrixView<T> &S21BasicMatrixView<T>::operator=(
+    const S21MatrixExpr<E> &expr) {
+  // размер вида изменить нельзя, в отличие от S21Matrix
+  s21_expr::CheckSameSize(*this, expr, "operator=: Incorrect matrix size");
+  Evaluate(expr.Self(), [](value_type, value_type value) { return value; });
+  return *this;
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrixView<T> &S21BasicMatrixView<T>::operator+=(
+    const S21MatrixExpr<E> &expr) {
+  s21_expr::CheckSameSize(*this, expr, "SumMatrix: Incorrect matrix size");
+  Evaluate(expr.Self(), s21_expr::Plus::Apply<value_type>);
+  return *this;
+}
+
+template <typename T>
+template <typename E>
+S21BasicMatrixView<T> &S21BasicMatrixView<T>::operator-=(
+    const S21MatrixExpr<E> &expr) {
+  s21_expr::CheckSameSize(*this, expr, "SubMatrix: Incorrect matrix size");
+  Evaluate(expr.Self(), s21_expr::Minus::Apply<value_type>);
+  return *this;
+}
+
+template <typename T>
+S21BasicMatrixView<T> &S21BasicMatrixView<T>::operator*=(value_type number) {
+  Evaluate(*this,
+           [number](value_type, value_type value) { return value * number; });
+  return *this;
+}
+
+#endif  // S21_MATRIX_VIEW_H_
@@ -235,6 +235,49 @@ TEST(Functions, Transpose) {
   ASSERT_TRUE(A.GetCols() == B.GetRows() && A.GetRows() == B.GetCols());
 }
 
+TEST(Functions, TransposeInPlace) {
+  // 70 не кратно ни блоку, ни плитке, шаг строк больше числа столбцов
+  S21Matrix A(70, 70);
+  TestCase::fillMatrix(A, 0, 1);
+  S21Matrix expected = A.Transpose();
+  const double *address = A.data();
+  A.TransposeInPlace();
+  ASSERT_EQ(A.data(), address);
+  ASSERT_TRUE(A == expected);
+  S21Matrix B(37, 50);
+  TestCase::fillMatrix(B, 0, 1);
+  expected = B.Transpose();
+  B.TransposeInPlace();
+  ASSERT_EQ(B.GetRows(), 50);
+  ASSERT_EQ(B.GetCols(), 37);
+  ASSERT_TRUE(B == expected);
+  // буфер прежнего размера освобождается и после перевыделения
+  B.AppendRow(B.data());
+  ASSERT_EQ(B(50, 36), expected(0, 36));
+  double data[] = {1, 2, 3, 4, 5, 6};
+  S21Matrix C = S21Matrix::Borrow(data, 2, 3);
+  C.TransposeInPlace();
+  ASSERT_EQ(C.data(), data);
+  ASSERT_EQ(data[1], 4);
+  ASSERT_EQ(C(2, 1), 6);
+  S21BasicMatrix<std::complex<double>> D(3, 3);
+  D(0, 2) = {1, 2};
+  D.TransposeInPlace();
+  ASSERT_EQ(D(2, 0), std::complex<double>(1, 2));
+  ASSERT_EQ(D(0, 2), std::complex<double>());
+  // хвосты строк чужого буфера с шагом 32 не затираются
+  std::vector<double> padded(30 * 32, -7.0);
+  S21Matrix E = S21Matrix::Borrow(padded.data(), 30, 30, S21Layout::kRowMajor,
+                                  32);
+  TestCase::fillMatrix(E, 0, 1);
+  E.TransposeInPlace();
+  ASSERT_EQ(E(29, 0), 29);
+  for (int i = 0; i < 30; ++i) {
+    ASSERT_EQ(padded[i * 32 + 30], -7.0);
+    ASSERT_EQ(padded[i * 32 + 31], -7.0);
+  }
+}
+
 TEST(Functions, Determinant1x1) {
   S21Matrix A(1, 1);
   A(0, 0) = 21;
@@ -522,4 +565,1657 @@ TEST(Operators, OutOfRange4) {
 TEST(Operators, InRange1) {
   S21Matrix matrix1(3, 4);
   ASSERT_TRUE(matrix1(2, 2) == 0);
-}
\ No newline at end of file
+}
+TEST(Storage, Contiguous) {
+  S21Matrix matrix(4, 3);
+  TestCase::fillMatrix(matrix, 1, 1);
+  const double *data = matrix.data();
+  ASSERT_GE(matrix.stride(), matrix.GetCols());
+  for (int i = 0; i < matrix.GetRows(); ++i) {
+    for (int j = 0; j < matrix.GetCols(); ++j) {
+      ASSERT_EQ(&matrix(i, j), data + i * matrix.stride() + j);
+    }
+  }
+}
+
+TEST(Storage, AlignedStride) {
+  S21Matrix matrix(5, 13);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(matrix.data()) % 64, 0u);
+  ASSERT_EQ(matrix.stride() % 8, 0);
+  matrix(4, 12) = 7;
+  matrix.SetCols(20);
+  ASSERT_TRUE(matrix(4, 12) == 7 && matrix(4, 19) == 0);
+  matrix.SetRows(2);
+  ASSERT_EQ(matrix.GetRows(), 2);
+}
+
+TEST(Storage, Empty) {
+  S21Matrix matrix(0, 5);
+  ASSERT_EQ(matrix.data(), nullptr);
+  EXPECT_ANY_THROW(S21Matrix(-1, 2));
+}
+
+TEST(Functions, DeterminantLarge) {
+  // верхнетреугольная матрица с переставленными строками
+  const int n = 12;
+  S21Matrix A(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = i; j < n; ++j) {
+      A(i, j) = (i == j) ? 2 : 1;
+    }
+  }
+  for (int j = 0; j < n; ++j) std::swap(A(0, j), A(n - 1, j));
+  ASSERT_NEAR(A.Determinant(), -4096, 1e-6);
+}
+
+TEST(Functions, DeterminantSingular) {
+  S21Matrix A(5, 5);
+  TestCase::fillMatrix(A, 1, 1);
+  ASSERT_NEAR(A.Determinant(), 0, 1e-7);
+}
+
+TEST(Functions, InverseMatrixLarge) {
+  const int n = 20;
+  S21Matrix A(n, n);
+  TestCase::genMatrix(A);
+  for (int i = 0; i < n; ++i) A(i, i) += 24 * n;
+  S21Matrix identity(n, n);
+  for (int i = 0; i < n; ++i) identity(i, i) = 1;
+  ASSERT_TRUE(A * A.InverseMatrix() == identity);
+}
+
+TEST(Functions, InverseMatrixSmallDeterminant) {
+  // определитель 1e-10, но матрица хорошо обусловлена
+  S21Matrix A(5, 5);
+  S21Matrix C(5, 5);
+  for (int i = 0; i < 5; ++i) {
+    A(i, i) = 0.01;
+    C(i, i) = 100;
+  }
+  ASSERT_TRUE(A.InverseMatrix() == C);
+}
+
+namespace TestCase {
+S21Matrix spdMatrix(int n) {
+  S21Matrix matrix(n, n);
+  genMatrix(matrix);
+  S21Matrix result = matrix.Transpose() * matrix;
+  for (int i = 0; i < n; ++i) result(i, i) += n;
+  return result;
+}
+}  // namespace TestCase
+
+TEST(Decomposition, LUSolve) {
+  S21Matrix A(6, 6);
+  TestCase::genMatrix(A);
+  for (int i = 0; i < 6; ++i) A(i, i) += 100;
+  S21Matrix B(6, 3);
+  TestCase::genMatrix(B);
+  S21LU lu(A);
+  ASSERT_TRUE(A * lu.Solve(B) == B);
+  ASSERT_NEAR(lu.Determinant(), A.Determinant(),
+              1e-6 * std::abs(lu.Determinant()));
+  ASSERT_TRUE(lu.Inverse() == A.InverseMatrix());
+}
+
+TEST(Decomposition, LUSingular) {
+  S21Matrix A(3, 3);
+  TestCase::fillMatrix(A, 1, 1);
+  S21LU lu(A);
+  ASSERT_TRUE(lu.IsSingular());
+  S21Matrix B(3, 1);
+  EXPECT_ANY_THROW(lu.Solve(B));
+  EXPECT_ANY_THROW(S21LU(S21Matrix(2, 3)));
+}
+
+TEST(Decomposition, Cholesky) {
+  S21Matrix A = TestCase::spdMatrix(5);
+  S21Matrix B(5, 2);
+  TestCase::genMatrix(B);
+  S21Cholesky cholesky(A);
+  ASSERT_TRUE(A * cholesky.Solve(B) == B);
+  ASSERT_NEAR(cholesky.Determinant(), A.Determinant(),
+              1e-6 * A.Determinant());
+  ASSERT_TRUE(cholesky.Inverse() == A.InverseMatrix());
+}
+
+TEST(Decomposition, CholeskyFail) {
+  S21Matrix A(2, 2);
+  A(0, 0) = 1, A(0, 1) = 2;
+  A(1, 0) = 2, A(1, 1) = 1;
+  EXPECT_ANY_THROW(S21Cholesky{A});
+}
+
+TEST(Decomposition, QRLeastSquares) {
+  // прямая y = 2x + 1 по точкам с симметричным шумом
+  S21Matrix A(4, 2);
+  S21Matrix b(4, 1);
+  const double noise[] = {0.1, -0.1, -0.1, 0.1};
+  for (int i = 0; i < 4; ++i) {
+    A(i, 0) = i;
+    A(i, 1) = 1;
+    b(i, 0) = 2 * i + 1 + noise[i];
+  }
+  S21Matrix x = S21QR(A).Solve(b);
+  ASSERT_EQ(x.GetRows(), 2);
+  ASSERT_NEAR(x(0, 0), 2, 1e-9);
+  ASSERT_NEAR(x(1, 0), 1, 1e-9);
+}
+
+TEST(Decomposition, QRSquare) {
+  S21Matrix A(5, 5);
+  TestCase::genMatrix(A);
+  for (int i = 0; i < 5; ++i) A(i, i) += 50;
+  S21QR qr(A);
+  ASSERT_NEAR(qr.Determinant(), A.Determinant(),
+              1e-6 * std::abs(qr.Determinant()));
+  ASSERT_TRUE(qr.Inverse() == A.InverseMatrix());
+  EXPECT_ANY_THROW(S21QR(S21Matrix(2, 3)));
+}
+
+namespace TestCase {
+// эталонное умножение тройным циклом
+S21Matrix naiveMul(const S21Matrix &a, const S21Matrix &b) {
+  S21Matrix result(a.GetRows(), b.GetCols());
+  for (int i = 0; i < a.GetRows(); ++i) {
+    for (int j = 0; j < b.GetCols(); ++j) {
+      for (int k = 0; k < a.GetCols(); ++k) {
+        result(i, j) += a(i, k) * b(k, j);
+      }
+    }
+  }
+  return result;
+}
+}  // namespace TestCase
+
+TEST(Functions, MulMatrixBlocked) {
+  // размеры не кратны блокам ядра
+  S21Matrix A(131, 270);
+  S21Matrix B(270, 77);
+  TestCase::genMatrix(A);
+  TestCase::genMatrix(B);
+  S21Matrix expected = TestCase::naiveMul(A, B);
+  A.MulMatrix(B);
+  ASSERT_TRUE(A == expected);
+}
+
+TEST(Functions, MulTransposedMatrix) {
+  S21Matrix A(45, 60);
+  S21Matrix B(37, 60);
+  TestCase::genMatrix(A);
+  TestCase::genMatrix(B);
+  S21Matrix expected = TestCase::naiveMul(A, B.Transpose());
+  A.MulTransposedMatrix(B);
+  ASSERT_TRUE(A == expected);
+  EXPECT_ANY_THROW(A.MulTransposedMatrix(S21Matrix(3, 3)));
+}
+
+namespace TestCase {
+// уровни, которые поддерживает текущий процессор
+std::vector<S21SimdLevel> simdLevels() {
+  std::vector<S21SimdLevel> levels;
+  for (S21SimdLevel level :
+       {S21SimdLevel::kScalar, S21SimdLevel::kNeon, S21SimdLevel::kAvx2,
+        S21SimdLevel::kAvx512}) {
+    try {
+      S21SetSimdLevel(level);
+      levels.push_back(level);
+    } catch (const std::logic_error &) {
+    }
+  }
+  S21SetSimdLevel(S21DetectSimdLevel());
+  return levels;
+}
+
+bool sameBits(const S21Matrix &a, const S21Matrix &b) {
+  bool flag = a.GetRows() == b.GetRows() && a.GetCols() == b.GetCols();
+  for (int i = 0; i < a.GetRows() && flag; ++i) {
+    flag = std::memcmp(&a(i, 0), &b(i, 0), a.GetCols() * sizeof(double)) == 0;
+  }
+  return flag;
+}
+}  // namespace TestCase
+
+TEST(Simd, DetectedLevelIsActive) {
+  ASSERT_EQ(S21GetSimdLevel(), S21DetectSimdLevel());
+}
+
+TEST(Simd, ElementWiseBitIdentical) {
+  // нечётные размеры задевают хвосты векторных циклов
+  S21Matrix A(7, 19);
+  S21Matrix B(7, 19);
+  TestCase::genMatrix(A);
+  TestCase::genMatrix(B);
+  B.MulNumber(0.37);
+  S21SetSimdLevel(S21SimdLevel::kScalar);
+  S21Matrix sum = A + B, sub = A - B, mul = A * 1.7;
+  for (S21SimdLevel level : TestCase::simdLevels()) {
+    S21SetSimdLevel(level);
+    ASSERT_TRUE(TestCase::sameBits(sum, A + B));
+    ASSERT_TRUE(TestCase::sameBits(sub, A - B));
+    ASSERT_TRUE(TestCase::sameBits(mul, A * 1.7));
+    ASSERT_TRUE(A == A);
+    ASSERT_FALSE(A == sum);
+  }
+  S21SetSimdLevel(S21DetectSimdLevel());
+}
+
+TEST(Simd, EqMatrixTail) {
+  S21Matrix A(3, 11);
+  TestCase::genMatrix(A);
+  S21Matrix B(A);
+  B(2, 10) += 1e-3;
+  for (S21SimdLevel level : TestCase::simdLevels()) {
+    S21SetSimdLevel(level);
+    ASSERT_FALSE(A == B);
+  }
+  S21SetSimdLevel(S21DetectSimdLevel());
+}
+
+TEST(Simd, GemmAcrossLevels) {
+  S21Matrix A(70, 90);
+  S21Matrix B(90, 45);
+  TestCase::genMatrix(A);
+  TestCase::genMatrix(B);
+  S21Matrix expected = TestCase::naiveMul(A, B);
+  for (S21SimdLevel level : TestCase::simdLevels()) {
+    S21SetSimdLevel(level);
+    ASSERT_TRUE(A * B == expected);
+  }
+  S21SetSimdLevel(S21DetectSimdLevel());
+}
+
+TEST(Simd, TransposeAcrossLevels) {
+  S21Matrix A(45, 67);
+  TestCase::genMatrix(A);
+  for (S21SimdLevel level : TestCase::simdLevels()) {
+    S21SetSimdLevel(level);
+    S21Matrix B = A.Transpose();
+    for (int i = 0; i < A.GetRows(); ++i) {
+      for (int j = 0; j < A.GetCols(); ++j) ASSERT_EQ(B(j, i), A(i, j));
+    }
+    S21Matrix C(B);
+    C.SetRows(45);
+    S21Matrix expected = C.Transpose();
+    C.TransposeInPlace();
+    ASSERT_TRUE(TestCase::sameBits(C, expected));
+  }
+  S21SetSimdLevel(S21DetectSimdLevel());
+}
+
+namespace TestCase {
+// включает потоки и отключает порог на время теста
+class ParallelScope {
+ private:
+  long threshold_;
+
+ public:
+  explicit ParallelScope(int threads) : threshold_(S21GetParallelThreshold()) {
+    S21SetNumThreads(threads);
+    S21SetParallelThreshold(0);
+  }
+  ~ParallelScope() {
+    S21SetNumThreads(1);
+    S21SetParallelThreshold(threshold_);
+  }
+};
+}  // namespace TestCase
+
+TEST(Parallel, Settings) {
+  ASSERT_EQ(S21GetNumThreads(), 1);
+  EXPECT_ANY_THROW(S21SetNumThreads(-1));
+  S21SetNumThreads(0);
+  ASSERT_GE(S21GetNumThreads(), 1);
+  S21SetNumThreads(1);
+}
+
+TEST(Parallel, MatchesSerial) {
+  S21Matrix A(150, 130);
+  S21Matrix B(130, 90);
+  S21Matrix C(150, 130);
+  TestCase::genMatrix(A);
+  TestCase::genMatrix(B);
+  TestCase::genMatrix(C);
+  S21Matrix square(60, 60);
+  TestCase::genMatrix(square);
+  for (int i = 0; i < 60; ++i) square(i, i) += 1500;
+
+  S21Matrix product = A * B, sum = A + C, sub = A - C, scaled = A * 0.5;
+  S21Matrix transposed = A.Transpose(), inverse = square.InverseMatrix();
+  double det = square.Determinant();
+
+  TestCase::ParallelScope scope(4);
+  ASSERT_TRUE(A * B == product);
+  ASSERT_TRUE(TestCase::sameBits(A + C, sum));
+  ASSERT_TRUE(TestCase::sameBits(A - C, sub));
+  ASSERT_TRUE(TestCase::sameBits(A * 0.5, scaled));
+  ASSERT_TRUE(TestCase::sameBits(A.Transpose(), transposed));
+  ASSERT_FALSE(A == C);
+  ASSERT_TRUE(square.InverseMatrix() == inverse);
+  ASSERT_NEAR(square.Determinant(), det, 1e-9 * std::abs(det));
+  // узкая и широкая формы делят работу по разным осям
+  S21Matrix wide(5, 400);
+  TestCase::genMatrix(wide);
+  ASSERT_TRUE(A.Transpose() * A == TestCase::naiveMul(transposed, A));
+  ASSERT_TRUE(wide.Transpose() * wide ==
+              TestCase::naiveMul(wide.Transpose(), wide));
+}
+
+TEST(Scheduler, DependenciesOrder) {
+  // ромб a -> (b, c) -> d и длинная независимая цепочка
+  for (int threads : {1, 4}) {
+    S21SetNumThreads(threads);
+    std::atomic<int> clock{0};
+    int a = -1, b = -1, c = -1, d = -1;
+    std::vector<int> chain(200, -1);
+    s21_kernels::TaskGraph graph;
+    auto ta = graph.Add([&] { a = clock++; });
+    auto tb = graph.Add([&] { b = clock++; }, {ta});
+    auto tc = graph.Add([&] { c = clock++; }, {ta});
+    graph.Add([&] { d = clock++; }, {tb, tc});
+    int previous = graph.Add([&] { chain[0] = clock++; });
+    for (int i = 1; i < 200; ++i) {
+      previous = graph.Add([&chain, &clock, i] { chain[i] = clock++; },
+                           {previous});
+    }
+    graph.Run();
+    ASSERT_TRUE(a < b && a < c && b < d && c < d);
+    for (int i = 1; i < 200; ++i) ASSERT_LT(chain[i - 1], chain[i]);
+    ASSERT_EQ(clock.load(), graph.GetSize());
+  }
+  S21SetNumThreads(1);
+}
+
+TEST(Scheduler, Exception) {
+  S21SetNumThreads(3);
+  s21_kernels::TaskGraph graph;
+  auto first = graph.Add([] {});
+  graph.Add([] { throw std::logic_error("task"); }, {first});
+  EXPECT_THROW(graph.Run(), std::logic_error);
+  EXPECT_ANY_THROW(graph.Add([] {}, {42}));
+  S21SetNumThreads(1);
+}
+
+TEST(Decomposition, TiledLU) {
+  // размер не кратен плитке, включается блочный путь
+  const int n = 300;
+  S21Matrix A(n, n);
+  TestCase::genMatrix(A);
+  S21Matrix B(n, 2);
+  TestCase::genMatrix(B);
+  for (int threads : {1, 4}) {
+    S21SetNumThreads(threads);
+    S21LU lu(A);
+    ASSERT_FALSE(lu.IsSingular());
+    ASSERT_TRUE(A * lu.Solve(B) == B);
+  }
+  S21SetNumThreads(1);
+  S21Matrix singular(n, n);
+  TestCase::genMatrix(singular);
+  for (int i = 0; i < n; ++i) singular(i, n / 2) = 0;
+  S21LU lu(singular);
+  ASSERT_TRUE(lu.IsSingular());
+  ASSERT_EQ(lu.Determinant(), 0);
+}
+
+TEST(Expressions, FusedChain) {
+  S21Matrix A(4, 5), B(4, 5), C(4, 5);
+  TestCase::genMatrix(A);
+  TestCase::genMatrix(B);
+  TestCase::genMatrix(C);
+  S21Matrix expected(A);
+  expected.SumMatrix(B);
+  S21Matrix twice(C);
+  twice.MulNumber(2.0);
+  expected.SubMatrix(twice);
+  S21Matrix result = A + B - C * 2.0;
+  ASSERT_TRUE(result == expected);
+  ASSERT_TRUE(A + B - 2.0 * C == expected);
+}
+
+TEST(Expressions, AssignReusesBuffer) {
+  S21Matrix A(3, 3), B(3, 3);
+  TestCase::genMatrix(A);
+  TestCase::genMatrix(B);
+  S21Matrix expected = A + B;
+  // приёмник совпадает с операндом
+  const double *buffer = A.data();
+  A = A + B;
+  ASSERT_EQ(A.data(), buffer);
+  ASSERT_TRUE(A == expected);
+  A -= B * 1.0;
+  A += B - B;
+  ASSERT_TRUE(A == expected - B);
+}
+
+TEST(Expressions, Resize) {
+  S21Matrix A(2, 2), B(2, 2);
+  TestCase::fillMatrix(A, 1, 1);
+  TestCase::fillMatrix(B, 1, 1);
+  S21Matrix C(5, 1);
+  C = A + B;
+  ASSERT_TRUE(C.GetRows() == 2 && C.GetCols() == 2 && C(1, 1) == 8);
+}
+
+TEST(Expressions, Product) {
+  S21Matrix A(3, 3), B(3, 3);
+  TestCase::fillMatrix(A, 1, 1);
+  TestCase::fillMatrix(B, 1, 1);
+  ASSERT_TRUE((A + B) * B == (A * B) + (B * B));
+}
+
+TEST(Expressions, SizeMismatch) {
+  S21Matrix A(3, 3), B(2, 3);
+  EXPECT_THROW(A + B, std::logic_error);
+  EXPECT_THROW(A - B, std::logic_error);
+  EXPECT_THROW(A += B * 2.0, std::logic_error);
+}
+
+// Подсчёт выделений памяти: глобальные operator new/delete заменены
+// для всего тестового бинарника, тесты сравнивают счётчик до и после.
+namespace TestCase {
+std::atomic<long> allocations{0};
+
+void *countedAlloc(std::size_t size, std::size_t alignment) {
+  ++allocations;
+  void *pointer = nullptr;
+  if (alignment <= alignof(std::max_align_t)) {
+    pointer = std::malloc(size ? size : 1);
+  } else {
+    pointer = std::aligned_alloc(
+        alignment, (size + alignment - 1) / alignment * alignment);
+  }
+  if (!pointer) throw std::bad_alloc();
+  return pointer;
+}
+
+// число выделений памяти при вызове func
+template <typename Func>
+long countAllocations(Func func) {
+  const long before = allocations.load();
+  func();
+  return allocations.load() - before;
+}
+}  // namespace TestCase
+
+void *operator new(std::size_t size) {
+  return TestCase::countedAlloc(size, alignof(std::max_align_t));
+}
+void *operator new[](std::size_t size) {
+  return TestCase::countedAlloc(size, alignof(std::max_align_t));
+}
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  return TestCase::countedAlloc(size, static_cast<std::size_t>(alignment));
+}
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  return TestCase::countedAlloc(size, static_cast<std::size_t>(alignment));
+}
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+void operator delete[](void *pointer) noexcept { std::free(pointer); }
+void operator delete(void *pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+void operator delete[](void *pointer, std::size_t) noexcept {
+  std::free(pointer);
+}
+void operator delete(void *pointer, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+void operator delete[](void *pointer, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+void operator delete[](void *pointer, std::size_t, std::align_val_t) noexcept {
+  std::free(pointer);
+}
+
+TEST(Allocations, CompoundOperators) {
+  S21Matrix A(20, 20), B(20, 20);
+  TestCase::genMatrix(A);
+  TestCase::genMatrix(B);
+  ASSERT_EQ(TestCase::countAllocations([&] { A += B; }), 0);
+  ASSERT_EQ(TestCase::countAllocations([&] { A -= B; }), 0);
+  ASSERT_EQ(TestCase::countAllocations([&] { A *= 2.0; }), 0);
+  ASSERT_EQ(TestCase::countAllocations([&] { A *= B; }), 1);
+  S21Matrix *address = nullptr;
+  ASSERT_EQ(TestCase::countAllocations([&] { address = &(A += B); }), 0);
+  ASSERT_EQ(address, &A);
+}
+
+TEST(Allocations, CopyAssignment) {
+  S21Matrix A(6, 9), B(6, 9), C(2, 2);
+  TestCase::genMatrix(A);
+  ASSERT_EQ(TestCase::countAllocations([&] { B = A; }), 0);
+  ASSERT_TRUE(B == A);
+  ASSERT_EQ(TestCase::countAllocations([&] { C = A; }), 1);
+  ASSERT_TRUE(C == A);
+  ASSERT_EQ(TestCase::countAllocations([&] { C = C; }), 0);
+  ASSERT_EQ(TestCase::countAllocations([&] { S21Matrix D(A); }), 1);
+}
+
+TEST(Allocations, Expressions) {
+  S21Matrix A(8, 8), B(8, 8), C(8, 8);
+  TestCase::genMatrix(A);
+  TestCase::genMatrix(B);
+  ASSERT_EQ(TestCase::countAllocations([&] { S21Matrix D = A + B - C * 2.0; }),
+            1);
+  ASSERT_EQ(TestCase::countAllocations([&] { C = A + B - C * 2.0; }), 0);
+  ASSERT_EQ(TestCase::countAllocations([&] { S21Matrix D = A * B; }), 1);
+  ASSERT_EQ(TestCase::countAllocations([&] { S21Matrix D = A.Transpose(); }),
+            1);
+}
+
+TEST(Capacity, InPlaceResize) {
+  S21Matrix A(4, 5);
+  TestCase::fillMatrix(A, 0, 1);
+  const double *address = A.data();
+  ASSERT_EQ(TestCase::countAllocations([&] {
+              A.SetRows(2);
+              A.SetCols(3);
+              A.SetRows(4);
+              A.SetCols(5);
+            }),
+            0);
+  ASSERT_EQ(A.data(), address);
+  ASSERT_EQ(A(1, 2), 7);
+  // открывшиеся элементы нулевые, а не остатки прежних значений
+  ASSERT_EQ(A(1, 4), 0);
+  ASSERT_EQ(A(3, 0), 0);
+  A.reserve(10, 20);
+  ASSERT_EQ(A.capacity(), 10);
+  ASSERT_GE(A.stride(), 20);
+  ASSERT_EQ(A.GetRows(), 4);
+  ASSERT_EQ(A(1, 2), 7);
+  ASSERT_EQ(TestCase::countAllocations([&] {
+              A.SetRows(10);
+              A.SetCols(20);
+            }),
+            0);
+  ASSERT_EQ(A(9, 19), 0);
+  A.SetRows(3);
+  A.shrink_to_fit();
+  ASSERT_EQ(A.capacity(), 3);
+  ASSERT_EQ(A.stride(), S21Matrix(1, 20).stride());
+  ASSERT_EQ(A(1, 2), 7);
+  ASSERT_THROW(A.reserve(-1, 2), std::length_error);
+}
+
+TEST(Capacity, Append) {
+  S21Matrix A(0, 3);
+  const double row[] = {1, 2, 3};
+  long allocations = TestCase::countAllocations([&] {
+    for (int i = 0; i < 1000; ++i) A.AppendRow(row);
+  });
+  ASSERT_EQ(A.GetRows(), 1000);
+  ASSERT_LE(allocations, 11);
+  ASSERT_EQ(A(999, 2), 3);
+  // строка самой матрицы переживает перевыделение
+  A.shrink_to_fit();
+  A.AppendRow(A.data());
+  ASSERT_EQ(A(1000, 1), 2);
+  S21Matrix B(4, 0);
+  const double col[] = {1, 2, 3, 4};
+  allocations = TestCase::countAllocations([&] {
+    for (int j = 0; j < 100; ++j) B.AppendCol(col);
+  });
+  ASSERT_EQ(B.GetCols(), 100);
+  ASSERT_LE(allocations, 8);
+  ASSERT_EQ(B(3, 99), 4);
+  double data[] = {1, 2, 3, 4};
+  S21Matrix C = S21Matrix::Borrow(data, 2, 2);
+  C.AppendCol(col);
+  ASSERT_NE(C.data(), data);
+  ASSERT_EQ(C(1, 1), 4);
+  ASSERT_EQ(C(1, 2), 2);
+}
+
+TEST(Memory, PoolReuse) {
+  S21PoolResource pool;
+  const double *address = nullptr;
+  {
+    S21Matrix A(10, 10, &pool);
+    ASSERT_EQ(A.GetResource(), &pool);
+    address = A.data();
+  }
+  S21Matrix B(10, 10, &pool);
+  ASSERT_EQ(B.data(), address);
+  ASSERT_EQ(B(9, 9), 0);
+  ASSERT_EQ(TestCase::countAllocations([&] {
+              for (int i = 0; i < 100; ++i) S21Matrix C(10, 10, &pool);
+            }),
+            0);
+}
+
+TEST(Memory, ThreadResource) {
+  S21PoolResource pool;
+  S21SetMemoryResource(&pool);
+  S21Matrix A(5, 5), B(5, 5);
+  TestCase::genMatrix(A);
+  S21Matrix C = A + B;
+  B.SetRows(7);
+  S21Matrix D(3, 3, std::pmr::get_default_resource());
+  D = A;
+  std::pmr::memory_resource *other = nullptr;
+  std::thread([&] { other = S21Matrix(2, 2).GetResource(); }).join();
+  S21SetMemoryResource(nullptr);
+  ASSERT_EQ(A.GetResource(), &pool);
+  ASSERT_EQ(C.GetResource(), &pool);
+  ASSERT_EQ(B.GetResource(), &pool);
+  ASSERT_EQ(D.GetResource(), std::pmr::get_default_resource());
+  ASSERT_TRUE(D == A);
+  ASSERT_EQ(other, std::pmr::get_default_resource());
+  ASSERT_EQ(S21GetMemoryResource(), std::pmr::get_default_resource());
+}
+
+TEST(Memory, ArenaReset) {
+  S21ArenaResource &arena = S21ThreadArena();
+  S21SetMemoryResource(&arena);
+  const double *first = nullptr;
+  for (int batch = 0; batch < 3; ++batch) {
+    long count = TestCase::countAllocations([&] {
+      S21Matrix A(16, 16), B(16, 16);
+      TestCase::genMatrix(A);
+      S21Matrix C = A + B;
+      if (!first) first = A.data();
+      ASSERT_EQ(A.data(), first);
+      ASSERT_EQ(reinterpret_cast<std::uintptr_t>(C.data()) % 64, 0u);
+    });
+    if (batch > 0) {
+      ASSERT_EQ(count, 0);
+    }
+    arena.Reset();
+  }
+  S21SetMemoryResource(nullptr);
+  arena.Release();
+}
+
+TEST(Memory, PoolThreads) {
+  S21PoolResource pool;
+  std::vector<std::thread> threads;
+  std::atomic<int> failures{0};
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < 200; ++i) {
+        S21Matrix A(3 + (i + t) % 9, 7, &pool);
+        A(0, 0) = t;
+        S21Matrix B(A.GetRows(), 7, &pool);
+        B += A;
+        if (B(0, 0) != t || B(A.GetRows() - 1, 6) != 0) ++failures;
+      }
+    });
+  }
+  for (std::thread &thread : threads) thread.join();
+  ASSERT_EQ(failures.load(), 0);
+}
+
+TEST(View, Block) {
+  S21Matrix A(5, 6);
+  TestCase::genMatrix(A);
+  S21MatrixView block = A.Block(1, 2, 3, 4);
+  ASSERT_EQ(block.GetRows(), 3);
+  ASSERT_EQ(block.GetCols(), 4);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 4; ++j) ASSERT_EQ(block(i, j), A(1 + i, 2 + j));
+  }
+  block(2, 3) = 100;
+  ASSERT_EQ(A(3, 5), 100);
+  ASSERT_EQ(block.Block(1, 1, 2, 3)(1, 2), 100);
+  ASSERT_THROW(A.Block(1, 2, 5, 1), std::out_of_range);
+  ASSERT_THROW(block.Block(-1, 0, 1, 1), std::out_of_range);
+  ASSERT_THROW(S21MatrixView(A.data(), -1, 2, 2), std::length_error);
+}
+
+TEST(View, AliasingAssignment) {
+  S21Matrix A(3, 3);
+  TestCase::fillMatrix(A, 0, 1);
+  S21Matrix expected = A.Transpose();
+  A = A.View().Transposed();
+  ASSERT_TRUE(A == expected);
+  expected = A + expected.Transpose();
+  A += A.View().Transposed();
+  ASSERT_TRUE(A == expected);
+  // B - строки 1..2 буфера M, блок M - строки 0..1: сдвиг на строку
+  S21Matrix M(3, 3);
+  TestCase::fillMatrix(M, 0, 1);
+  S21Matrix B = S21Matrix::Borrow(M.data() + M.stride(), 2, 3,
+                                  S21Layout::kRowMajor, M.stride());
+  expected = B + M.Block(0, 0, 2, 3);
+  B += M.Block(0, 0, 2, 3);
+  ASSERT_TRUE(B == expected);
+  expected = B - M.Block(0, 0, 2, 3) * 2.0;
+  B -= M.Block(0, 0, 2, 3) * 2.0;
+  ASSERT_TRUE(B == expected);
+}
+
+TEST(View, RowColTransposed) {
+  S21Matrix A(4, 7);
+  TestCase::genMatrix(A);
+  const S21Matrix &B = A;
+  S21ConstMatrixView row = B.View().Row(2), col = B.View().Col(5);
+  for (int j = 0; j < 7; ++j) ASSERT_EQ(row(0, j), A(2, j));
+  for (int i = 0; i < 4; ++i) ASSERT_EQ(col(i, 0), A(i, 5));
+  S21Matrix T = A.View().Transposed();
+  ASSERT_TRUE(T == A.Transpose());
+  ASSERT_EQ(A.View().Transposed().Row(5)(0, 3), A(3, 5));
+  double buffer[] = {1, 2, 3, 4, 5, 6};
+  S21ConstMatrixView external(buffer, 2, 3, 1, 2);
+  ASSERT_EQ(external(1, 2), 6);
+  ASSERT_EQ(external(0, 1), 3);
+}
+
+TEST(View, Expressions) {
+  S21Matrix A(6, 6), B(6, 6), C(6, 6);
+  TestCase::genMatrix(B);
+  TestCase::genMatrix(C);
+  S21Matrix expected = A;
+  A.Block(2, 2, 3, 3) = B.Block(0, 0, 3, 3) + C.Block(3, 3, 3, 3) * 2.0;
+  A.View().Col(0) += B.View().Row(1).Transposed();
+  A.Block(0, 1, 2, 2) -= C.Block(0, 0, 2, 2);
+  A.View().Row(5) *= 3.0;
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      expected(2 + i, 2 + j) = B(i, j) + C(3 + i, 3 + j) * 2.0;
+    }
+  }
+  for (int i = 0; i < 6; ++i) expected(i, 0) += B(1, i);
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 2; ++j) expected(i, 1 + j) -= C(i, j);
+  }
+  for (int j = 0; j < 6; ++j) expected(5, j) *= 3.0;
+  ASSERT_TRUE(A == expected);
+  S21Matrix D = A.Block(1, 1, 2, 2) - B.Block(0, 0, 2, 2);
+  ASSERT_EQ(D(1, 1), A(2, 2) - B(1, 1));
+  ASSERT_THROW(A.Block(0, 0, 2, 2) = B, std::logic_error);
+  ASSERT_THROW(A.View().Row(0) += B.View().Col(0), std::logic_error);
+}
+
+TEST(View, Multiply) {
+  S21Matrix A(70, 90), B(60, 80), C(40, 40);
+  TestCase::genMatrix(A);
+  TestCase::genMatrix(B);
+  S21ConstMatrixView a = A.Block(3, 5, 50, 64);
+  S21ConstMatrixView b = B.Block(2, 7, 50, 64).Transposed();
+  S21Matrix expected = TestCase::naiveMul(S21Matrix(a), S21Matrix(b));
+  S21Matrix product = a * b;
+  ASSERT_TRUE(product == expected);
+  ASSERT_TRUE(A.Block(0, 0, 3, 90) * A.View().Transposed() ==
+              TestCase::naiveMul(S21Matrix(A.Block(0, 0, 3, 90)),
+                                 A.Transpose()));
+  // приёмник по столбцам и приёмник с произвольными шагами
+  S21Matrix transposed(50, 50);
+  S21MulAdd(a, b, transposed.View().Transposed());
+  ASSERT_TRUE(transposed == expected.Transpose());
+  std::vector<double> buffer(4 * 50 * 50);
+  S21MatrixView strided(buffer.data(), 50, 50, 2 * 50 * 2, 2);
+  S21MulAdd(a, b, strided, 2.0);
+  ASSERT_TRUE(S21Matrix(strided) == expected * 2.0);
+  ASSERT_THROW(S21MulAdd(a, a, C.View()), std::logic_error);
+  ASSERT_THROW(S21Matrix(a * a), std::logic_error);
+}
+
+TEST(View, NoCopies) {
+  S21Matrix A(8, 8), B(8, 8);
+  TestCase::genMatrix(A);
+  ASSERT_EQ(TestCase::countAllocations([&] {
+              S21Matrix D = A.Block(0, 0, 4, 8) * B.View().Transposed();
+            }),
+            1);
+  ASSERT_EQ(TestCase::countAllocations(
+                [&] { B.Block(0, 0, 4, 4) = A.Block(4, 4, 4, 4) * 2.0; }),
+            0);
+}
+
+TEST(External, Adopt) {
+  int deleted = 0;
+  double *data = new double[6]{1, 2, 3, 4, 5, 6};
+  {
+    S21Matrix A = S21Matrix::Adopt(data, 2, 3, [&](double *buffer) {
+      ++deleted;
+      delete[] buffer;
+    });
+    ASSERT_EQ(A.data(), data);
+    ASSERT_EQ(A.stride(), 3);
+    ASSERT_EQ(A(1, 0), 4);
+    A *= 2.0;
+    ASSERT_EQ(data[5], 12);
+    S21Matrix B = std::move(A);
+    ASSERT_EQ(deleted, 0);
+  }
+  ASSERT_EQ(deleted, 1);
+  double *strided = new double[11]{1, 2, -1, -1, 3, 4, -1, -1, 5, 6, -1};
+  S21Matrix C = S21Matrix::Adopt(
+      strided, 3, 2, [](double *buffer) { delete[] buffer; },
+      S21Layout::kRowMajor, 4);
+  ASSERT_EQ(C(2, 1), 6);
+  S21Matrix copy(C);
+  ASSERT_TRUE(copy == C);
+  ASSERT_EQ(copy.Transpose()(1, 2), 6);
+}
+
+TEST(External, AdoptColMajor) {
+  const int rows = 7, cols = 5;
+  double *data = new double[rows * cols];
+  for (int j = 0; j < cols; ++j) {
+    for (int i = 0; i < rows; ++i) data[j * rows + i] = i * 10 + j;
+  }
+  S21Matrix A = S21Matrix::Adopt(
+      data, rows, cols, [](double *buffer) { delete[] buffer; },
+      S21Layout::kColMajor);
+  ASSERT_EQ(A.data(), data);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) ASSERT_EQ(A(i, j), i * 10 + j);
+  }
+  double square[] = {1, 3, 2, 4};
+  ASSERT_THROW(S21Matrix::Adopt(square, 2, 2, nullptr, S21Layout::kColMajor,
+                                3),
+               std::logic_error);
+}
+
+TEST(External, Borrow) {
+  double data[] = {1, 2, 3, 4, 5, 6};
+  {
+    S21Matrix A = S21Matrix::Borrow(data, 3, 2);
+    A(2, 1) = 60;
+    S21Matrix B(3, 2);
+    TestCase::fillMatrix(B, 1, 1);
+    A += B;
+    A.SetRows(2);
+    ASSERT_NE(A.data(), data);
+    A(0, 0) = -1;
+  }
+  ASSERT_EQ(data[0], 2);
+  ASSERT_EQ(data[5], 66);
+  ASSERT_THROW(S21Matrix::Borrow(data, 2, 3, S21Layout::kColMajor),
+               std::logic_error);
+  ASSERT_THROW(S21Matrix::Borrow(data, 3, 2, S21Layout::kRowMajor, 1),
+               std::logic_error);
+  ASSERT_THROW(S21Matrix::Borrow(nullptr, 3, 2), std::logic_error);
+  ASSERT_THROW(S21Matrix::Borrow(data, -1, 2), std::length_error);
+}
+
+TEST(External, Release) {
+  S21Matrix A(3, 3);
+  TestCase::fillMatrix(A, 1, 1);
+  const int stride = A.stride();
+  S21Matrix::Buffer buffer = A.release();
+  ASSERT_EQ(A.GetRows(), 0);
+  ASSERT_EQ(A.data(), nullptr);
+  ASSERT_EQ(buffer[2 * stride + 2], 9);
+  int deleted = 0;
+  double *data = new double[4]{1, 2, 3, 4};
+  S21Matrix B = S21Matrix::Adopt(data, 2, 2, [&](double *pointer) {
+    ++deleted;
+    delete[] pointer;
+  });
+  S21Matrix::Buffer adopted = B.release();
+  ASSERT_EQ(adopted.get(), data);
+  ASSERT_EQ(deleted, 0);
+  adopted.reset();
+  ASSERT_EQ(deleted, 1);
+}
+
+namespace TestCase {
+// матрица с диагональным преобладанием, копия которой лежит в S21Matrix
+template <int N>
+S21FixedMatrix<N, N> fixedMatrix(S21Matrix &copy) {
+  copy = S21Matrix(N, N);
+  genMatrix(copy);
+  for (int i = 0; i < N; ++i) copy(i, i) += 24 * N;
+  return S21FixedMatrix<N, N>(copy);
+}
+
+template <int N>
+void checkFixed() {
+  S21Matrix A;
+  S21FixedMatrix<N, N> fixed = fixedMatrix<N>(A);
+  const double det = A.Determinant();
+  ASSERT_NEAR(fixed.Determinant(), det, std::abs(det) * 1e-12);
+  ASSERT_TRUE(fixed.InverseMatrix().ToMatrix() == A.InverseMatrix());
+  // дополнения порядка det, поэтому сравниваются после нормировки
+  ASSERT_TRUE((fixed.CalcComplements() * (1 / det)).ToMatrix() ==
+              A.CalcComplements() * (1 / det));
+  ASSERT_TRUE((fixed * fixed.InverseMatrix()).ToMatrix() ==
+              (A * A.InverseMatrix()));
+}
+}  // namespace TestCase
+
+TEST(Fixed, Constexpr) {
+  constexpr S21FixedMatrix<2, 2> A{4, 7, 2, 6};
+  static_assert(A.Determinant() == 10);
+  constexpr S21FixedMatrix<2, 3> B{1, 2, 3, 4, 5, 6};
+  constexpr S21FixedMatrix<2, 3> product = A * B;
+  static_assert(product(1, 2) == 2 * 3 + 6 * 6);
+  static_assert(B.Transpose()(2, 1) == 6);
+  constexpr S21FixedMatrix<2, 2> identity = A * A.InverseMatrix();
+  static_assert(identity == S21FixedMatrix<2, 2>{1, 0, 0, 1});
+  static_assert(S21FixedMatrix<3, 3>{2, 0, 0, 0, 3, 0, 0, 0, 4}.Determinant() ==
+                24);
+  static_assert(S21FixedMatrix<5, 5>{1, 0, 0, 0, 0, 0, 2}.Determinant() == 0);
+}
+
+TEST(Fixed, MatchesDynamic) {
+  TestCase::checkFixed<1>();
+  TestCase::checkFixed<2>();
+  TestCase::checkFixed<3>();
+  TestCase::checkFixed<4>();
+  TestCase::checkFixed<5>();
+  TestCase::checkFixed<6>();
+}
+
+TEST(Fixed, Operations) {
+  S21Matrix a, b;
+  S21FixedMatrix<4, 4> A = TestCase::fixedMatrix<4>(a);
+  S21FixedMatrix<4, 4> B = TestCase::fixedMatrix<4>(b);
+  ASSERT_TRUE((A + B * 2.0 - B).ToMatrix() == a + b * 2.0 - b);
+  ASSERT_TRUE((2.0 * A).ToMatrix() == a * 2.0);
+  A *= B;
+  a *= b;
+  ASSERT_TRUE(A.ToMatrix() == a);
+  A += B;
+  A -= B;
+  ASSERT_TRUE(A.ToMatrix() == a);
+  ASSERT_TRUE(A.Transpose().ToMatrix() == a.Transpose());
+  ASSERT_EQ(A.View()(3, 2), a(3, 2));
+  ASSERT_THROW(A(4, 0), std::out_of_range);
+  ASSERT_THROW((S21FixedMatrix<3, 3>(a)), std::logic_error);
+  ASSERT_THROW((S21FixedMatrix<1, 2>{1, 2, 3}), std::length_error);
+  ASSERT_THROW((S21FixedMatrix<3, 3>{1, 2, 3, 2, 4, 6}.InverseMatrix()),
+               std::logic_error);
+  S21FixedMatrix<6, 6> singular;
+  ASSERT_THROW(singular.InverseMatrix(), std::logic_error);
+  ASSERT_EQ(TestCase::countAllocations([&] {
+              S21FixedMatrix<4, 4> C = A * B.InverseMatrix() + A;
+              C.MulNumber(C.Determinant());
+            }),
+            0);
+}
+
+namespace TestCase {
+// копия матрицы double в матрицу с элементами типа T
+template <typename T>
+S21BasicMatrix<T> convert(const S21Matrix &matrix) {
+  S21BasicMatrix<T> result(matrix.GetRows(), matrix.GetCols());
+  for (int i = 0; i < matrix.GetRows(); ++i) {
+    for (int j = 0; j < matrix.GetCols(); ++j) result(i, j) = T(matrix(i, j));
+  }
+  return result;
+}
+
+template <typename T>
+void checkType() {
+  S21Matrix a(5, 5), b(5, 5);
+  genMatrix(a);
+  genMatrix(b);
+  for (int i = 0; i < 5; ++i) a(i, i) += 120;
+  S21BasicMatrix<T> A = convert<T>(a), B = convert<T>(b);
+  ASSERT_TRUE(A + B * T(2) - B == convert<T>(a + b));
+  ASSERT_TRUE(A * B == convert<T>(a * b));
+  ASSERT_TRUE(A.Transpose() == convert<T>(a.Transpose()));
+  const S21BasicMatrix<T> identity = A * A.InverseMatrix();
+  for (int i = 0; i < 5; ++i) {
+    for (int j = 0; j < 5; ++j) {
+      ASSERT_LT(std::abs(identity(i, j) - T(i == j ? 1 : 0)), 1e-4);
+    }
+  }
+  const double det = a.Determinant();
+  ASSERT_LT(std::abs(A.Determinant() - T(det)), std::abs(det) * 1e-5);
+  const S21Matrix small(a.Block(1, 1, 3, 3));
+  const double small_det = small.Determinant();
+  ASSERT_LT(std::abs(convert<T>(small).Determinant() - T(small_det)),
+            std::abs(small_det) * 1e-5);
+}
+}  // namespace TestCase
+
+TEST(Types, Operations) {
+  TestCase::checkType<float>();
+  TestCase::checkType<double>();
+  TestCase::checkType<long double>();
+  TestCase::checkType<std::complex<double>>();
+}
+
+TEST(Types, Tolerance) {
+  S21MatrixF A(2, 2);
+  S21MatrixF B(A);
+  B(1, 1) = 5e-5f;
+  ASSERT_TRUE(A == B);
+  B(1, 1) = 5e-4f;
+  ASSERT_FALSE(A == B);
+  S21MatrixLD C(2, 2);
+  S21MatrixLD D(C);
+  D(0, 1) = 1e-8L;
+  ASSERT_FALSE(C == D);
+  S21MatrixC E(1, 2);
+  S21MatrixC F(E);
+  F(0, 0) = {0, 1e-3};
+  ASSERT_FALSE(E == F);
+  F(0, 0) = {1e-8, 1e-8};
+  ASSERT_TRUE(E == F);
+  ASSERT_THROW(S21MatrixC(2, 2).InverseMatrix(), std::logic_error);
+}
+
+TEST(Types, ComplexValues) {
+  S21MatrixC A(2, 2);
+  A(0, 0) = {0, 1};
+  A(0, 1) = {1, 0};
+  A(1, 0) = {2, 0};
+  A(1, 1) = {0, -1};
+  // (i)(-i) - 1 * 2 = -1
+  ASSERT_LT(std::abs(A.Determinant() - std::complex<double>(-1, 0)), 1e-12);
+  S21MatrixC product = A * A;
+  ASSERT_LT(std::abs(product(0, 0) - std::complex<double>(1, 0)), 1e-12);
+  S21MatrixC identity(2, 2);
+  identity(0, 0) = identity(1, 1) = 1;
+  ASSERT_TRUE(A * A.InverseMatrix() == identity);
+}
+
+TEST(Types, FloatKernels) {
+  S21Matrix a(7, 37), b(7, 37);
+  TestCase::genMatrix(a);
+  TestCase::genMatrix(b);
+  S21MatrixF A = TestCase::convert<float>(a);
+  S21MatrixF B = TestCase::convert<float>(b);
+  S21SetSimdLevel(S21SimdLevel::kScalar);
+  S21MatrixF sum(A), sub(A), scaled(A);
+  sum.SumMatrix(B);
+  sub.SubMatrix(B);
+  scaled.MulNumber(1.7f);
+  for (S21SimdLevel level : TestCase::simdLevels()) {
+    S21SetSimdLevel(level);
+    S21MatrixF C(A), D(A), E(A);
+    C.SumMatrix(B);
+    D.SubMatrix(B);
+    E.MulNumber(1.7f);
+    for (int i = 0; i < A.GetRows(); ++i) {
+      ASSERT_EQ(std::memcmp(&C(i, 0), &sum(i, 0), A.GetCols() * sizeof(float)),
+                0);
+      ASSERT_EQ(std::memcmp(&D(i, 0), &sub(i, 0), A.GetCols() * sizeof(float)),
+                0);
+      ASSERT_EQ(
+          std::memcmp(&E(i, 0), &scaled(i, 0), A.GetCols() * sizeof(float)),
+          0);
+    }
+  }
+  S21SetSimdLevel(S21DetectSimdLevel());
+}
+
+namespace TestCase {
+// партия из count матриц с диагональным преобладанием и их копии
+S21MatrixBatch genBatch(int count, int rows, int cols,
+                        std::vector<S21Matrix> &copies) {
+  S21MatrixBatch batch(count, rows, cols);
+  copies.assign(count, S21Matrix(rows, cols));
+  for (int k = 0; k < count; ++k) {
+    genMatrix(copies[k]);
+    for (int i = 0; i < std::min(rows, cols); ++i) copies[k](i, i) += 24 * rows;
+    batch.Set(k, copies[k]);
+  }
+  return batch;
+}
+}  // namespace TestCase
+
+TEST(Batch, Layout) {
+  S21MatrixBatch batch(13, 2, 3);
+  ASSERT_EQ(batch.GetCount(), 13);
+  batch(12, 1, 2) = 5;
+  ASSERT_EQ(batch.data()[(1 * 3 + 2) * S21MatrixBatch::kLanes + 12], 5);
+  ASSERT_EQ(batch.Get(12)(1, 2), 5);
+  ASSERT_EQ(batch.Get(11)(1, 2), 0);
+  ASSERT_THROW(batch(13, 0, 0), std::out_of_range);
+  ASSERT_THROW(batch.Get(-1), std::out_of_range);
+  ASSERT_THROW(batch.Set(0, S21Matrix(3, 2)), std::logic_error);
+  ASSERT_THROW(S21MatrixBatch(-1, 2, 2), std::length_error);
+  S21MatrixBatch copy(batch);
+  ASSERT_EQ(copy(12, 1, 2), 5);
+}
+
+TEST(Batch, MatchesSingle) {
+  for (int threads : {1, 4}) {
+    TestCase::ParallelScope scope(threads);
+    std::vector<S21Matrix> a, b, c;
+    // 150 - не кратно размеру куска
+    S21MatrixBatch A = TestCase::genBatch(150, 5, 5, a);
+    S21MatrixBatch B = TestCase::genBatch(150, 5, 3, b);
+    S21MatrixBatch product = S21BatchMul(A, B);
+    S21MatrixBatch square = S21BatchMul(A, A);
+    std::vector<double> det = S21BatchDeterminant(A);
+    S21MatrixBatch inverse = S21BatchInverse(A);
+    S21MatrixBatch solution = S21BatchSolve(A, B);
+    for (int k = 0; k < A.GetCount(); ++k) {
+      ASSERT_TRUE(product.Get(k) == a[k] * b[k]);
+      ASSERT_TRUE(square.Get(k) == a[k] * a[k]);
+      const double expected = a[k].Determinant();
+      ASSERT_NEAR(det[k], expected, std::abs(expected) * 1e-12);
+      ASSERT_TRUE(inverse.Get(k) == a[k].InverseMatrix());
+      ASSERT_TRUE(a[k] * solution.Get(k) == b[k]);
+    }
+  }
+}
+
+TEST(Batch, Singular) {
+  std::vector<S21Matrix> a;
+  S21MatrixBatch A = TestCase::genBatch(70, 3, 3, a);
+  // вырожденная матрица во втором куске
+  A.Set(66, S21Matrix(3, 3));
+  std::vector<double> det = S21BatchDeterminant(A);
+  ASSERT_EQ(det[66], 0);
+  ASSERT_NE(det[65], 0);
+  ASSERT_THROW(S21BatchInverse(A), std::logic_error);
+  ASSERT_THROW(S21BatchSolve(A, A), std::logic_error);
+  ASSERT_THROW(S21BatchSolve(A, S21MatrixBatch(70, 2, 3)), std::logic_error);
+  ASSERT_THROW(S21BatchMul(A, S21MatrixBatch(69, 3, 3)), std::logic_error);
+  ASSERT_THROW(S21BatchDeterminant(S21MatrixBatch(2, 2, 3)), std::logic_error);
+}
+
+TEST(Batch, NearlySingular) {
+  // ведущий элемент меньше EPSILON: определитель мал, но не ноль,
+  // а обращение отказывает - так же, как у S21Matrix
+  std::vector<S21Matrix> a;
+  for (int size : {3, 6}) {
+    S21MatrixBatch A = TestCase::genBatch(9, size, size, a);
+    // верхний треугольник из единиц, последняя строка почти равна первой
+    S21Matrix m(size, size);
+    for (int i = 0; i < size - 1; ++i) {
+      for (int j = i; j < size; ++j) m(i, j) = 1;
+    }
+    for (int j = 0; j < size; ++j) m(size - 1, j) = 1;
+    m(size - 1, size - 1) += 1e-9;
+    A.Set(5, m);
+    a[5] = m;
+    std::vector<double> det = S21BatchDeterminant(A);
+    for (int k = 0; k < A.GetCount(); ++k) {
+      const double expected = a[k].Determinant();
+      ASSERT_NEAR(det[k], expected, std::abs(expected) * 1e-6);
+    }
+    ASSERT_NE(det[5], 0);
+    ASSERT_THROW(m.InverseMatrix(), std::logic_error);
+    ASSERT_THROW(S21BatchInverse(A), std::logic_error);
+  }
+}
+
+TEST(Batch, AcrossLevels) {
+  std::vector<S21Matrix> a;
+  S21MatrixBatch A = TestCase::genBatch(37, 4, 4, a);
+  for (S21SimdLevel level : TestCase::simdLevels()) {
+    S21SetSimdLevel(level);
+    S21MatrixBatch product = S21BatchMul(A, A);
+    S21MatrixBatch inverse = S21BatchInverse(A);
+    for (int k = 0; k < A.GetCount(); ++k) {
+      ASSERT_TRUE(product.Get(k) == a[k] * a[k]);
+      ASSERT_TRUE(inverse.Get(k) == a[k].InverseMatrix());
+    }
+  }
+  S21SetSimdLevel(S21DetectSimdLevel());
+}
+
+namespace TestCase {
+// плотная матрица, в которой ненулевой примерно каждый пятый элемент
+S21Matrix genSparse(int rows, int cols) {
+  S21Matrix result(rows, cols);
+  genMatrix(result);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      if (rand() % 5 != 0) result(i, j) = 0;
+    }
+  }
+  return result;
+}
+}  // namespace TestCase
+
+TEST(Sparse, Conversion) {
+  S21Matrix dense = TestCase::genSparse(17, 23);
+  for (S21SparseFormat format :
+       {S21SparseFormat::kCsr, S21SparseFormat::kCsc}) {
+    S21SparseMatrix A(dense, format);
+    ASSERT_EQ(A.GetFormat(), format);
+    ASSERT_TRUE(A.ToDense() == dense);
+    ASSERT_TRUE(A.EqMatrix(dense));
+    ASSERT_EQ(A(16, 22), dense(16, 22));
+    int nonzeros = 0;
+    for (int i = 0; i < 17; ++i) {
+      for (int j = 0; j < 23; ++j) nonzeros += dense(i, j) != 0;
+    }
+    ASSERT_EQ(A.NonZeros(), nonzeros);
+    ASSERT_EQ(A.Offsets().size(), format == S21SparseFormat::kCsr ? 18u : 24u);
+    S21SparseMatrix B = A.Convert(format == S21SparseFormat::kCsr
+                                      ? S21SparseFormat::kCsc
+                                      : S21SparseFormat::kCsr);
+    ASSERT_NE(B.GetFormat(), format);
+    ASSERT_TRUE(B == A);
+    ASSERT_TRUE(B.ToDense() == dense);
+    ASSERT_THROW(A(17, 0), std::out_of_range);
+  }
+  ASSERT_THROW(S21SparseMatrix(-1, 2), std::length_error);
+}
+
+TEST(Sparse, Triplets) {
+  S21SparseMatrix A = S21SparseMatrix::FromTriplets(
+      3, 4, {{2, 3, 1.5}, {0, 1, 2}, {2, 3, 1.5}, {1, 0, 4}, {1, 2, -1},
+             {1, 2, 1}});
+  ASSERT_EQ(A.NonZeros(), 3);
+  ASSERT_EQ(A(2, 3), 3);
+  ASSERT_EQ(A(0, 1), 2);
+  ASSERT_EQ(A(1, 2), 0);
+  S21SparseMatrix B = S21SparseMatrix::FromTriplets(
+      3, 4, {{1, 0, 4}, {2, 3, 3}, {0, 1, 2}}, S21SparseFormat::kCsc);
+  ASSERT_TRUE(A == B);
+  ASSERT_THROW(S21SparseMatrix::FromTriplets(3, 4, {{3, 0, 1}}),
+               std::out_of_range);
+}
+
+TEST(Sparse, SumTranspose) {
+  S21Matrix a = TestCase::genSparse(30, 20), b = TestCase::genSparse(30, 20);
+  S21SparseMatrix A(a), B(b, S21SparseFormat::kCsc);
+  ASSERT_TRUE((A + B).EqMatrix(a + b));
+  ASSERT_TRUE((A - B).EqMatrix(a - b));
+  ASSERT_TRUE((B - B).NonZeros() == 0);
+  ASSERT_TRUE((A * 3.0).EqMatrix(a * 3.0));
+  ASSERT_TRUE(A.Transpose().EqMatrix(a.Transpose()));
+  ASSERT_TRUE(B.Transpose().EqMatrix(b.Transpose()));
+  ASSERT_EQ(B.Transpose().GetFormat(), S21SparseFormat::kCsc);
+  A += B;
+  A -= B;
+  A *= 2;
+  ASSERT_TRUE(A.EqMatrix(a * 2.0));
+  ASSERT_FALSE(A.EqMatrix(a));
+  ASSERT_FALSE(A == A.Transpose());
+  ASSERT_THROW(A + A.Transpose(), std::logic_error);
+}
+
+TEST(Sparse, Multiply) {
+  S21Matrix a = TestCase::genSparse(60, 45), b = TestCase::genSparse(45, 50);
+  S21Matrix dense(45, 7);
+  TestCase::genMatrix(dense);
+  for (int threads : {1, 4}) {
+    TestCase::ParallelScope scope(threads);
+    for (S21SparseFormat format :
+         {S21SparseFormat::kCsr, S21SparseFormat::kCsc}) {
+      S21SparseMatrix A(a, format), B(b, format);
+      S21SparseMatrix C(b, S21SparseFormat::kCsr);
+      ASSERT_TRUE((A * B).EqMatrix(a * b));
+      ASSERT_TRUE((A * C).EqMatrix(a * b));
+      ASSERT_EQ((A * B).GetFormat(), format);
+      ASSERT_TRUE(A * dense == a * dense);
+      std::vector<double> x(45), y(60);
+      for (int i = 0; i < 45; ++i) x[i] = dense(i, 3);
+      A.MulVector(x.data(), y.data());
+      S21Matrix expected = a * dense;
+      for (int i = 0; i < 60; ++i) ASSERT_NEAR(y[i], expected(i, 3), 1e-9);
+      ASSERT_THROW(A * A, std::logic_error);
+    }
+  }
+}
+
+namespace TestCase {
+// пятиточечный оператор -u'' на сетке side x side; с convection
+// добавляется несимметричный перенос по строкам
+S21SparseMatrix laplacian(int side, double convection = 0.0) {
+  std::vector<S21Triplet> triplets;
+  for (int i = 0; i < side; ++i) {
+    for (int j = 0; j < side; ++j) {
+      const int row = i * side + j;
+      triplets.push_back({row, row, 4.0});
+      if (i > 0) triplets.push_back({row, row - side, -1.0});
+      if (i + 1 < side) triplets.push_back({row, row + side, -1.0});
+      if (j > 0) triplets.push_back({row, row - 1, -1.0 - convection});
+      if (j + 1 < side) triplets.push_back({row, row + 1, -1.0 + convection});
+    }
+  }
+  return S21SparseMatrix::FromTriplets(side * side, side * side, triplets);
+}
+
+double residual(const S21LinearOperator &a, const std::vector<double> &b,
+                const std::vector<double> &x) {
+  std::vector<double> ax(b.size());
+  a.Apply(x.data(), ax.data());
+  double sum = 0, norm = 0;
+  for (std::size_t i = 0; i < b.size(); ++i) {
+    sum += (b[i] - ax[i]) * (b[i] - ax[i]);
+    norm += b[i] * b[i];
+  }
+  return std::sqrt(sum / norm);
+}
+}  // namespace TestCase
+
+TEST(Solvers, ConjugateGradient) {
+  S21SparseMatrix A = TestCase::laplacian(20);
+  S21SparseOperator op(A);
+  std::vector<double> b(400, 1.0);
+  S21JacobiPreconditioner jacobi(A);
+  S21Ilu0Preconditioner ilu(A);
+  int plain_iterations = 0;
+  for (const S21Preconditioner *preconditioner :
+       {static_cast<const S21Preconditioner *>(nullptr),
+        static_cast<const S21Preconditioner *>(&jacobi),
+        static_cast<const S21Preconditioner *>(&ilu)}) {
+    std::vector<double> x;
+    S21SolverReport report = S21SolveCG(op, b, x, {}, preconditioner);
+    ASSERT_TRUE(report.converged);
+    ASSERT_EQ(report.history.size(), std::size_t(report.iterations));
+    ASSERT_LE(report.residual, 1e-10);
+    ASSERT_LE(TestCase::residual(op, b, x), 1e-9);
+    if (!preconditioner) plain_iterations = report.iterations;
+    if (preconditioner == &ilu) {
+      ASSERT_LT(report.iterations, plain_iterations);
+    }
+  }
+}
+
+TEST(Solvers, Nonsymmetric) {
+  S21SparseMatrix A = TestCase::laplacian(16, 0.4);
+  S21SparseMatrix csc = A.Convert(S21SparseFormat::kCsc);
+  S21SparseOperator op(A), op_csc(csc);
+  std::vector<double> b(256);
+  for (int i = 0; i < 256; ++i) b[i] = (i % 7) - 3.0;
+  S21Ilu0Preconditioner ilu(csc);
+  for (int threads : {1, 4}) {
+    TestCase::ParallelScope scope(threads);
+    for (const S21Preconditioner *preconditioner :
+         {static_cast<const S21Preconditioner *>(nullptr),
+          static_cast<const S21Preconditioner *>(&ilu)}) {
+      std::vector<double> x;
+      S21SolverReport report = S21SolveGMRES(op, b, x, {}, preconditioner);
+      ASSERT_TRUE(report.converged);
+      ASSERT_LE(TestCase::residual(op, b, x), 1e-9);
+      x.clear();
+      report = S21SolveBiCGSTAB(op_csc, b, x, {}, preconditioner);
+      ASSERT_TRUE(report.converged);
+      ASSERT_LE(TestCase::residual(op, b, x), 1e-9);
+    }
+  }
+}
+
+TEST(Solvers, DenseAndReport) {
+  S21Matrix A(30, 30);
+  TestCase::genMatrix(A);
+  for (int i = 0; i < 30; ++i) A(i, i) += 400;
+  S21DenseOperator op(A);
+  S21JacobiPreconditioner jacobi(A);
+  std::vector<double> b(30, 2.0), x;
+  S21SolverReport report = S21SolveGMRES(op, b, x, {1e-12, 100, 5}, &jacobi);
+  ASSERT_TRUE(report.converged);
+  S21Matrix rhs(30, 1);
+  for (int i = 0; i < 30; ++i) rhs(i, 0) = 2.0;
+  S21Matrix expected = S21LU(A).Solve(rhs);
+  for (int i = 0; i < 30; ++i) ASSERT_NEAR(x[i], expected(i, 0), 1e-9);
+  // начальное приближение - уже решение
+  report = S21SolveBiCGSTAB(op, b, x);
+  ASSERT_TRUE(report.converged);
+  ASSERT_EQ(report.iterations, 0);
+  // ограничение числа итераций
+  std::vector<double> y;
+  report = S21SolveCG(S21SparseOperator(TestCase::laplacian(20)),
+                      std::vector<double>(400, 1.0), y, {1e-12, 3});
+  ASSERT_FALSE(report.converged);
+  ASSERT_EQ(report.iterations, 3);
+  ASSERT_GT(report.residual, 1e-12);
+  std::vector<double> zero(30, 0.0);
+  report = S21SolveCG(op, zero, x);
+  ASSERT_TRUE(report.converged);
+  ASSERT_EQ(x[0], 0);
+  // обрыв BiCGSTAB: shadow * v = 0 на первом же шаге
+  S21Matrix swap(2, 2);
+  swap(0, 1) = swap(1, 0) = 1;
+  std::vector<double> z;
+  report = S21SolveBiCGSTAB(S21DenseOperator(swap), {1.0, 0.0}, z);
+  ASSERT_FALSE(report.converged);
+  ASSERT_EQ(report.iterations, 0);
+  ASSERT_TRUE(std::isfinite(z[0]) && std::isfinite(z[1]));
+  ASSERT_THROW(S21SolveCG(op, std::vector<double>(3), x), std::logic_error);
+  ASSERT_THROW(S21SolveGMRES(op, b, x, {1e-10, 10, 0}), std::logic_error);
+  ASSERT_THROW(S21DenseOperator(S21Matrix(2, 3)), std::logic_error);
+  ASSERT_THROW(S21JacobiPreconditioner(S21Matrix(2, 2)), std::logic_error);
+  ASSERT_THROW(S21Ilu0Preconditioner(S21SparseMatrix(2, 2)), std::logic_error);
+}
+
+TEST(Strassen, Shapes) {
+  // целые элементы: все промежуточные суммы точны
+  for (auto [m, k, n] : {std::array<int, 3>{64, 64, 64}, {67, 45, 53},
+                         {100, 31, 9}, {5, 80, 70}, {1, 1, 1}, {0, 4, 3}}) {
+    S21Matrix a(m, k), b(k, n);
+    TestCase::genMatrix(a);
+    TestCase::genMatrix(b);
+    for (int threads : {1, 4}) {
+      TestCase::ParallelScope scope(threads);
+      for (int cutoff : {1, 4, 16, kS21StrassenCutoff}) {
+        ASSERT_TRUE(S21MulStrassen(a.View(), b.View(), cutoff) == a * b);
+      }
+    }
+  }
+}
+
+TEST(Strassen, ViewsAndErrors) {
+  S21Matrix a(40, 30), b(40, 30);
+  TestCase::genMatrix(a);
+  TestCase::genMatrix(b);
+  S21Matrix expected = S21MulMatrix(a.View(), b.View().Transposed());
+  ASSERT_TRUE(S21MulStrassen(a.View(), b.View().Transposed(), 3) == expected);
+  ASSERT_TRUE(S21MulStrassen(a.Block(1, 2, 20, 25),
+                             b.View().Transposed().Block(2, 3, 25, 19), 5) ==
+              S21MulMatrix(a.Block(1, 2, 20, 25),
+                           b.View().Transposed().Block(2, 3, 25, 19)));
+  // погрешность на нецелых данных - в пределах допуска сравнения
+  S21Matrix c(90, 90);
+  for (int i = 0; i < 90; ++i) {
+    for (int j = 0; j < 90; ++j) c(i, j) = std::sin(i * 0.7 + j * 1.3);
+  }
+  ASSERT_TRUE(S21MulStrassen(c.View(), c.View(), 2) == c * c);
+  ASSERT_THROW(S21MulStrassen(a.View(), b.View()), std::logic_error);
+  ASSERT_THROW(S21MulStrassen(a.View(), a.View().Transposed(), 0),
+               std::logic_error);
+}
+
+namespace TestCase {
+std::string tempFile(const std::string &name) {
+  return testing::TempDir() + "s21_" + name + ".s21m";
+}
+}  // namespace TestCase
+
+TEST(Binary, RoundTrip) {
+  S21Matrix a(37, 23);
+  TestCase::genMatrix(a);
+  a(3, 4) = 1.0 / 3.0;
+  const std::string path = TestCase::tempFile("round_trip");
+  for (S21Layout layout : {S21Layout::kRowMajor, S21Layout::kColMajor}) {
+    S21SaveMatrix(path, a, layout);
+    S21Matrix loaded = S21LoadMatrix<double>(path);
+    ASSERT_EQ(loaded.GetRows(), 37);
+    ASSERT_EQ(loaded.GetCols(), 23);
+    ASSERT_TRUE(TestCase::sameBits(loaded, a));
+  }
+  S21Matrix block = a.Block(2, 3, 10, 7);
+  S21SaveMatrix(path, block);
+  ASSERT_TRUE(S21LoadMatrix<double>(path) == block);
+  S21SaveMatrix(path, S21Matrix(0, 5));
+  ASSERT_EQ(S21LoadMatrix<double>(path).GetCols(), 5);
+  const S21MatrixF f = TestCase::convert<float>(a);
+  S21SaveMatrix(path, f, S21Layout::kColMajor);
+  ASSERT_TRUE(S21LoadMatrix<float>(path) == f);
+  const S21MatrixC c = TestCase::convert<std::complex<double>>(a);
+  S21SaveMatrix(path, c);
+  ASSERT_TRUE(S21LoadMatrix<std::complex<double>>(path) == c);
+  ASSERT_THROW(S21LoadMatrix<double>(path), std::logic_error);
+  ASSERT_THROW(S21LoadMatrix<double>(path + ".missing"), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(Binary, MappedAndStreaming) {
+  S21Matrix a(50, 31);
+  TestCase::genMatrix(a);
+  const std::string path = TestCase::tempFile("streaming");
+  for (S21Layout layout : {S21Layout::kRowMajor, S21Layout::kColMajor}) {
+    {
+      // линии по одной, как при записи матрицы больше памяти
+      S21MatrixWriter writer(path, 50, 31, layout);
+      const S21Matrix lines =
+          layout == S21Layout::kRowMajor ? a : a.Transpose();
+      for (int i = 0; i < lines.GetRows(); ++i) {
+        writer.Write(lines.data() + i * lines.stride());
+      }
+      ASSERT_THROW(writer.Write(lines.data()), std::logic_error);
+      writer.Close();
+    }
+    S21MappedMatrix mapped(path);
+    ASSERT_EQ(mapped.GetLayout(), layout);
+    ASSERT_EQ(mapped.GetType(), S21DataType::kDouble);
+    ASSERT_TRUE(S21Matrix(mapped.View<double>()) == a);
+    ASSERT_EQ(mapped.View<double>()(7, 9), a(7, 9));
+    ASSERT_THROW(mapped.View<float>(), std::logic_error);
+    S21MappedMatrix moved(std::move(mapped));
+    ASSERT_TRUE(moved.View<double>() * a.Transpose() == a * a.Transpose());
+  }
+  {
+    // незаконченная запись не читается как матрица
+    S21MatrixWriter writer(path, 3, 3);
+    writer.Write(a.Block(0, 0, 2, 3));
+    ASSERT_THROW(writer.Close(), std::logic_error);
+  }
+  ASSERT_THROW(S21LoadMatrix<double>(path), std::runtime_error);
+  ASSERT_THROW(S21MappedMatrix{path}, std::runtime_error);
+  // испорченный элемент ловится контрольной суммой
+  S21SaveMatrix(path, a);
+  std::FILE *file = std::fopen(path.c_str(), "r+b");
+  std::fseek(file, 64 + 100, SEEK_SET);
+  std::fputc(0x5a, file);
+  std::fclose(file);
+  ASSERT_THROW(S21LoadMatrix<double>(path), std::runtime_error);
+  ASSERT_THROW(S21MappedMatrix{path}, std::runtime_error);
+  ASSERT_EQ(S21MappedMatrix(path, false).GetRows(), 50);
+  ASSERT_THROW(S21MatrixWriter(path, 2, 2).Write(a.View()),
+               std::logic_error);
+  // 2^30 x 2^30 по 16 байт: произведение размеров переполняется до нуля
+  S21SaveMatrix(path, S21BasicMatrix<std::complex<double>>(1, 1));
+  file = std::fopen(path.c_str(), "r+b");
+  const std::int64_t huge[] = {std::int64_t(1) << 30, std::int64_t(1) << 30};
+  std::fseek(file, 24, SEEK_SET);
+  std::fwrite(huge, sizeof(huge), 1, file);
+  std::fclose(file);
+  ASSERT_THROW(S21MappedMatrix(path, false), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(Tiled, Operations) {
+  // плитки 16 x 16 и кэш на 3 плитки: матрицы заведомо не помещаются
+  S21TileOptions options;
+  options.tile = 16;
+  options.cache_bytes = 3 * 16 * 16 * sizeof(double);
+  S21Matrix a(45, 37), b(45, 37), c(37, 29);
+  TestCase::genMatrix(a);
+  TestCase::genMatrix(b);
+  TestCase::genMatrix(c);
+  const std::string path = testing::TempDir() + "s21_tiled";
+  for (bool prefetch : {false, true}) {
+    options.prefetch = prefetch;
+    S21TiledMatrix A(path + "_a", 45, 37, options);
+    S21TiledMatrix B(path + "_b", 45, 37, options);
+    S21TiledMatrix C(path + "_c", 37, 29, options);
+    A.Store(a, 0, 0);
+    B.Store(b.Block(0, 0, 20, 37), 0, 0);
+    B.Store(b.Block(20, 0, 25, 37), 20, 0);
+    C.Store(c, 0, 0);
+    ASSERT_EQ(A.TileRows(), 3);
+    ASSERT_EQ(A.TileCols(), 3);
+    ASSERT_TRUE(A.ToDense() == a);
+    ASSERT_TRUE(B.Load(5, 7, 30, 20) == b.Block(5, 7, 30, 20));
+    ASSERT_TRUE(A.MulMatrix(C, path + "_ac").ToDense() == a * c);
+    ASSERT_TRUE(A.Transpose(path + "_at").ToDense() == a.Transpose());
+    A.SumMatrix(B);
+    A.MulNumber(2.0);
+    A.SubMatrix(B);
+    ASSERT_TRUE(A.ToDense() == (a + b) * 2.0 - b);
+    A.Set(44, 36, -1.5);
+    ASSERT_EQ(A(44, 36), -1.5);
+    ASSERT_THROW(A.SumMatrix(C), std::logic_error);
+    ASSERT_THROW(A.MulMatrix(A, path + "_aa"), std::logic_error);
+    ASSERT_THROW(A(45, 0), std::out_of_range);
+    ASSERT_THROW(A.Store(c, 10, 10), std::out_of_range);
+  }
+  // изменённые плитки записываются в файл и переживают объект
+  {
+    S21TiledMatrix A(path + "_a", 45, 37, options);
+    A.Store(a, 0, 0);
+  }
+  S21TiledMatrix reopened = S21TiledMatrix::Open(path + "_a", options);
+  ASSERT_EQ(reopened.GetRows(), 45);
+  ASSERT_TRUE(reopened.ToDense() == a);
+  ASSERT_THROW(S21TiledMatrix::Open(path + "_missing"), std::runtime_error);
+  for (const char *suffix : {"_a", "_b", "_c", "_ac", "_at"}) {
+    std::remove((path + suffix).c_str());
+  }
+}
+
+TEST(Tiled, CacheAndPrefetch) {
+  S21TileOptions options;
+  options.tile = 8;
+  options.cache_bytes = 4 * 8 * 8 * sizeof(double);
+  const std::string path = testing::TempDir() + "s21_tiled_cache";
+  S21Matrix a(64, 64);
+  TestCase::genMatrix(a);
+  long misses[2] = {0, 0};
+  for (bool prefetch : {false, true}) {
+    options.prefetch = prefetch;
+    S21TiledMatrix A(path, 64, 64, options);
+    A.Store(a, 0, 0);
+    A.Flush();
+    const S21TileStats before = A.Stats();
+    A.MulNumber(-1.0);
+    const S21TileStats after = A.Stats();
+    // 64 плитки через кэш на 4: каждая читается один раз
+    ASSERT_EQ(after.misses - before.misses, 64);
+    ASSERT_GE(after.writes - before.writes, 60);
+    misses[prefetch] = after.prefetched - before.prefetched;
+    ASSERT_TRUE(A.ToDense() == a * -1.0);
+  }
+  ASSERT_EQ(misses[0], 0);
+  ASSERT_GT(misses[1], 0);
+  std::remove(path.c_str());
+}
+
+TEST(Text, Parse) {
+  S21Matrix expected(2, 3);
+  TestCase::fillMatrix(expected, 1.0, 0.5);
+  expected(1, 2) = -1e-3;
+  ASSERT_TRUE(S21ParseText("1,1.5,2\n2.5, 3 ,-1e-3\n") == expected);
+  ASSERT_TRUE(S21ParseText("\n1;1.5;2\r\n\r\n2.5;3;-0.001") == expected);
+  ASSERT_TRUE(S21ParseText("  1 1.5\t2\n2.5 +3 -1e-3\n\n") == expected);
+  ASSERT_TRUE(S21ParseText("1|1.5|2\n2.5|3|-1e-3", {'|'}) == expected);
+  ASSERT_EQ(S21ParseText("\n \n").GetRows(), 0);
+  ASSERT_EQ(S21ParseText("7").GetCols(), 1);
+  ASSERT_THROW(S21ParseText("1,2\n3\n"), std::invalid_argument);
+  ASSERT_THROW(S21ParseText("1,2\n3,4,5\n"), std::invalid_argument);
+  ASSERT_THROW(S21ParseText("1,2,\n3,4,\n"), std::invalid_argument);
+  ASSERT_THROW(S21ParseText("1 2\n3 x\n"), std::invalid_argument);
+  ASSERT_THROW(S21ParseText("1,2\n3;4\n"), std::invalid_argument);
+  try {
+    S21ParseText("1 2\n\n3 4\n5 6 7\n");
+    FAIL();
+  } catch (const std::invalid_argument &error) {
+    ASSERT_NE(std::string(error.what()).find("line 4"), std::string::npos);
+  }
+}
+
+TEST(Text, RoundTrip) {
+  // больше одного куска разбора
+  S21Matrix a(3000, 40);
+  for (int i = 0; i < 3000; ++i) {
+    for (int j = 0; j < 40; ++j) a(i, j) = std::sin(i * 40.0 + j) * 1e3;
+  }
+  const std::string path = testing::TempDir() + "s21_text.csv";
+  for (int threads : {1, 4}) {
+    TestCase::ParallelScope scope(threads);
+    S21WriteText(path, a);
+    const S21Matrix loaded = S21ReadText(path);
+    ASSERT_TRUE(TestCase::sameBits(loaded, a));
+    const std::string text = S21FormatText(a, {' ', 4});
+    ASSERT_EQ(text.substr(0, text.find(' ')), "0");
+    const S21Matrix rounded = S21ParseText(text);
+    ASSERT_FALSE(rounded.EqMatrix(a));
+    ASSERT_EQ(rounded.GetRows(), 3000);
+    ASSERT_NEAR(rounded(1, 1), a(1, 1), 1.0);
+  }
+  ASSERT_EQ(S21FormatText(S21Matrix(2, 2), {';', 0}), "0;0\n0;0\n");
+  ASSERT_THROW(S21FormatText(a, {',', 18}), std::logic_error);
+  ASSERT_THROW(S21ReadText(path + ".missing"), std::runtime_error);
+  std::remove(path.c_str());
+}
@@ -3,6 +3,33 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../main_functions/s21_matrix_batch.h"
+#include "../main_functions/s21_matrix_binary.h"
+#include "../main_functions/s21_matrix_decomposition.h"
+#include "../main_functions/s21_matrix_fixed.h"
+#include "../main_functions/s21_matrix_memory.h"
 #include "../main_functions/s21_matrix_oop.h"
+#include "../main_functions/s21_matrix_parallel.h"
+#include "../main_functions/s21_matrix_scheduler.h"
+#include "../main_functions/s21_matrix_simd.h"
+#include "../main_functions/s21_matrix_solvers.h"
+#include "../main_functions/s21_matrix_sparse.h"
+#include "../main_functions/s21_matrix_strassen.h"
+#include "../main_functions/s21_matrix_text.h"
+#include "../main_functions/s21_matrix_tiled.h"
+#include "../main_functions/s21_matrix_view.h"
 
 #endif  // S21_MATRIX_OOP_H_TEST
\ No newline at end of file